@@ -0,0 +1,673 @@
+/**
+ * @file benchmarks-vec4state.cc
+ * @brief Benchmarks for the vec4state and vec4state_fixed classes.
+ *
+ * This file contains the benchmarks for the vec4state and vec4state_fixed classes. Besides the time of each operation, every benchmark reports the average number of heap allocations per operation (allocs/op), which is counted by replacing the global allocation functions. The file is built twice: benchmarks-vec4state uses the default 64-bit limbs and benchmarks-vec4state-limb32 uses 32-bit limbs, so the two limb widths can be compared.
+ *
+ * @author Mia Ekheizer, Yuval Shasha
+ * @date 2026-10-16
+ */
+
+#include <benchmark/benchmark.h>
+#include "vec4state.h"
+#include "vec4stateFixed.h"
+#include "vec4stateExpr.h"
+#include <cstdlib>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The number of heap allocations performed since the start of the program.
+ */
+static long long allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+// GCC inlines these into callers that allocated with the replaced operator new and then reports free as mismatched, although the replaced operator new allocates with malloc.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+void* operator new(size_t size, align_val_t alignment) {
+    allocationCount++;
+#ifdef _MSC_VER
+    void* ptr = _aligned_malloc(size == 0 ? 1 : size, size_t(alignment));
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    size_t alignedSize = (size + size_t(alignment) - 1) / size_t(alignment) * size_t(alignment);
+    void* ptr = aligned_alloc(size_t(alignment), alignedSize == 0 ? size_t(alignment) : alignedSize);
+#endif
+    if (ptr == nullptr) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+/// Frees memory that was allocated by the aligned operator new.
+void freeAligned(void* ptr) {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, size_t, align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+/// Reports the average number of heap allocations per iteration of the benchmark.
+void reportAllocations(benchmark::State& state, long long allocations) {
+    state.counters["allocs/op"] = benchmark::Counter(double(allocations), benchmark::Counter::kAvgIterations);
+}
+
+/// Creates a vector of numBits bits that holds a repeating pattern of known bits.
+vec4state makeKnownVector(long long numBits) {
+    string bits;
+    for (long long i = 0; i < numBits; i++) {
+        bits += (i % 3 == 0) ? ONE : ZERO;
+    }
+    return vec4state(bits);
+}
+
+/// Creates a vector of numBits bits that holds a repeating pattern of known and unknown bits.
+vec4state makeUnknownVector(long long numBits) {
+    string bits;
+    for (long long i = 0; i < numBits; i++) {
+        bits += (i % 4 == 0) ? X : ((i % 4 == 1) ? Z : ONE);
+    }
+    return vec4state(bits);
+}
+
+/// Measures the copy of a vector of state.range(0) bits.
+static void BM_Copy(benchmark::State& state) {
+    vec4state first = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Copy)->Arg(64)->Arg(4096);
+
+/// Measures the parsing of a string of state.range(0) bits by the string constructor.
+static void BM_StringConstructor(benchmark::State& state) {
+    const char bitValues[] = {ZERO, ONE, X, Z};
+    string bits;
+    for (long long i = 0; i < state.range(0); i++) {
+        bits += bitValues[(i * 7 + i / 3) % 4];
+    }
+    for (auto _ : state) {
+        vec4state result(bits);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringConstructor)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+/// Measures the parsing of a corpus of a million mixed SystemVerilog literals by fromLiteral.
+static void BM_FromLiteral(benchmark::State& state) {
+    const char* literals[] = {"8'hFF", "16'b1x0z_1010_0110", "32'd123456", "'d42", "12'o7_?x", "64'hDEAD_BEEF_CAFE_F00D", "'1", "4'sd5"};
+    const long long numLiterals = 1 << 20;
+    vector<string> corpus;
+    for (long long i = 0; i < numLiterals; i++) {
+        corpus.push_back(literals[(i * 5 + i / 8) % 8]);
+    }
+    for (auto _ : state) {
+        for (const string& literal : corpus) {
+            vec4state result = vec4state::fromLiteral(literal);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numLiterals);
+}
+BENCHMARK(BM_FromLiteral)->Unit(benchmark::kMillisecond);
+
+/// Measures the representation of a known vector of state.range(0) bits in the radix state.range(1).
+static void BM_ToStringRadix(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    for (auto _ : state) {
+        string result = first.toString(int(state.range(1)));
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ToStringRadix)->Args({64, 16})->Args({4096, 16})->Args({64, 10})->Args({256, 10})->Args({4096, 10})->Args({65536, 10});
+
+/// Measures the creation of a vector of state.range(0) x bits with the fill constructor.
+static void BM_FillConstructor(benchmark::State& state) {
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result(X, state.range(0));
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_FillConstructor)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+/// Measures the string representation of a vector of state.range(0) bits, returned as a string (state.range(1) == 0) or written into a buffer with toChars (state.range(1) == 1).
+static void BM_ToString(benchmark::State& state) {
+    vec4state first = makeUnknownVector(state.range(0));
+    string buf(size_t(state.range(0)), ZERO);
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            string result = first.toString();
+            benchmark::DoNotOptimize(result);
+        } else {
+            benchmark::DoNotOptimize(first.toChars(&buf[0], buf.size()));
+            benchmark::ClobberMemory();
+        }
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_ToString)->Args({64, 0})->Args({64, 1})->Args({4096, 0})->Args({4096, 1})->Args({1 << 20, 0})->Args({1 << 20, 1});
+
+/// Measures the bitwise AND of two vectors of state.range(0) bits.
+static void BM_BitwiseAnd(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first & second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_BitwiseAnd)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->Arg(256)->Arg(4096);
+
+/// Measures the bitwise OR of two vectors of state.range(0) bits.
+static void BM_BitwiseOr(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first | second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_BitwiseOr)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->Arg(4096);
+
+/// Measures the bitwise XOR of two vectors of state.range(0) bits.
+static void BM_BitwiseXor(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first ^ second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_BitwiseXor)->Arg(32)->Arg(256)->Arg(4096);
+
+/// Measures the bitwise XNOR of two vectors of state.range(0) bits.
+static void BM_BitwiseXnor(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first.xnor(second);
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_BitwiseXnor)->Arg(32)->Arg(256)->Arg(4096);
+
+/// Measures the bitwise NOT of a vector of state.range(0) bits.
+static void BM_BitwiseNot(benchmark::State& state) {
+    vec4state first = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = ~first;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_BitwiseNot)->Arg(64)->Arg(4096);
+
+/// Measures the logical equality of two vectors of state.range(0) bits.
+static void BM_Equality(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first == second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Equality)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->Arg(4096);
+
+/// Measures the logical equality of two vectors of state.range(0) bits that are different in their LSB.
+static void BM_EqualityFirstMismatch(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = first ^ 1;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first == second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_EqualityFirstMismatch)->Arg(64)->Arg(4096);
+
+/// Measures the less than relational operator of two vectors of state.range(0) bits.
+static void BM_LessThan(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first < second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_LessThan)->Arg(1)->Arg(8)->Arg(32)->Arg(64);
+
+/// Measures the logical NOT of a vector of state.range(0) bits.
+static void BM_LogicalNot(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = !first;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_LogicalNot)->Arg(1)->Arg(8)->Arg(32)->Arg(64);
+
+/// Measures the logical AND of two vectors of state.range(0) bits.
+static void BM_LogicalAnd(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first && second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_LogicalAnd)->Arg(1)->Arg(8)->Arg(32)->Arg(64);
+
+/// Measures the addition of two vectors of state.range(0) bits.
+static void BM_Add(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first + second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Add)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->Arg(256)->Arg(1024)->Arg(4096);
+
+/// Measures v4::add into a reused destination on vectors of state.range(0) bits, with operands that hold a repeating pattern (state.range(1) == 0), or with all ones plus one, where the carry propagates through every limb (state.range(1) == 1).
+static void BM_AddCarryChain(benchmark::State& state) {
+    long long numBits = state.range(0);
+    vec4state first = state.range(1) ? vec4state(string(numBits, ONE)) : makeKnownVector(numBits);
+    vec4state second = state.range(1) ? vec4state(1) : makeKnownVector(numBits);
+    vec4state result;
+    v4::add(result, first, second);
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        v4::add(result, first, second);
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_AddCarryChain)->Args({64, 0})->Args({64, 1})->Args({1024, 0})->Args({1024, 1})->Args({65536, 0})->Args({65536, 1});
+
+/// Measures v4::sub into a reused destination on vectors of state.range(0) bits, with operands that hold a repeating pattern (state.range(1) == 0), or with 100...0 minus one, where the borrow propagates through every limb (state.range(1) == 1).
+static void BM_SubBorrowChain(benchmark::State& state) {
+    long long numBits = state.range(0);
+    vec4state first = state.range(1) ? vec4state("1" + string(numBits - 1, ZERO)) : makeKnownVector(numBits);
+    vec4state second = state.range(1) ? vec4state(1) : makeKnownVector(numBits);
+    vec4state result;
+    v4::sub(result, first, second);
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        v4::sub(result, first, second);
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_SubBorrowChain)->Args({64, 0})->Args({64, 1})->Args({1024, 0})->Args({1024, 1})->Args({65536, 0})->Args({65536, 1});
+
+/// Measures an accumulate loop that assigns the sum back to the accumulator (acc = acc + x) on vectors of state.range(0) bits.
+static void BM_Accumulate(benchmark::State& state) {
+    vec4state accumulator = makeKnownVector(state.range(0));
+    vec4state addend = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        accumulator = accumulator + addend;
+        benchmark::DoNotOptimize(accumulator);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Accumulate)->Arg(64)->Arg(4096);
+
+/// Measures an accumulate loop into the accumulator (acc = acc + x) on vectors of state.range(0) bits with v4::add, which adds a bit to the accumulator on every carry out (state.range(1) == 0), or with v4::addWrap, which keeps its width (state.range(1) == 1).
+static void BM_AccumulateWrap(benchmark::State& state) {
+    vec4state accumulator = makeKnownVector(state.range(0));
+    vec4state addend = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        if (state.range(1)) {
+            v4::addWrap(accumulator, accumulator, addend);
+        } else {
+            v4::add(accumulator, accumulator, addend);
+        }
+        benchmark::DoNotOptimize(accumulator);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+    state.counters["bits"] = double(accumulator.getNumBits());
+}
+BENCHMARK(BM_AccumulateWrap)->Args({64, 0})->Args({64, 1})->Args({4096, 0})->Args({4096, 1});
+
+/// Measures an accumulate loop that updates the accumulator with the compound assignment operators (acc += x; acc ^= x; acc <<= 1) on vectors of state.range(0) bits, which should not allocate in steady state.
+static void BM_AccumulateCompound(benchmark::State& state) {
+    vec4state accumulator = makeKnownVector(state.range(0));
+    vec4state addend = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        accumulator += addend;
+        accumulator ^= addend;
+        accumulator <<= 1;
+        benchmark::DoNotOptimize(accumulator);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_AccumulateCompound)->Arg(64)->Arg(4096);
+
+/// Measures a chained expression of bitwise operators ((a & b) | c) ^ d on vectors of state.range(0) bits, where the outer operators reuse the planes of the temporaries.
+static void BM_ChainedBitwise(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    vec4state third = makeKnownVector(state.range(0));
+    vec4state fourth = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = ((first & second) | third) ^ fourth;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_ChainedBitwise)->Arg(64)->Arg(256)->Arg(4096);
+
+/// Measures the same chained expression as BM_ChainedBitwise as a lazy expression, which is evaluated in a single pass into the result.
+static void BM_ChainedBitwiseLazy(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    vec4state third = makeKnownVector(state.range(0));
+    vec4state fourth = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = ((lazy(first) & second) | third) ^ fourth;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_ChainedBitwiseLazy)->Arg(64)->Arg(256)->Arg(4096);
+
+/// Measures a chain of 8 bitwise operators on vectors of state.range(0) bits, evaluated eagerly (state.range(1) == 0) or as a lazy expression (state.range(1) == 1).
+static void BM_LongBitwiseChain(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeUnknownVector(state.range(0));
+    vec4state third = makeKnownVector(state.range(0));
+    vec4state fourth = makeUnknownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            vec4state result = ~(((first & second) | (third ^ fourth)) & ~(first | fourth)) ^ (second & third);
+            benchmark::DoNotOptimize(result);
+        } else {
+            vec4state result = ~(((lazy(first) & second) | (lazy(third) ^ fourth)) & ~(lazy(first) | fourth)) ^ (lazy(second) & third);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_LongBitwiseChain)->Args({256, 0})->Args({256, 1})->Args({4096, 0})->Args({4096, 1});
+
+/// Measures a simulated clock cycle of a register of state.range(0) bits, evaluated with the operators (state.range(1) == 0) or with the three-address functions into preallocated vectors (state.range(1) == 1).
+static void BM_ClockCycle(benchmark::State& state) {
+    vec4state reg = makeKnownVector(state.range(0));
+    vec4state input = makeKnownVector(state.range(0));
+    vec4state mask = makeUnknownVector(state.range(0));
+    vec4state next = reg;
+    vec4state output = reg;
+    vec4state scratch = reg;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            next = (reg - input) & mask;
+            output = next ^ (next >> 1);
+        } else {
+            v4::sub(next, reg, input);
+            v4::band(next, next, mask);
+            v4::shr(scratch, next, 1);
+            v4::bxor(output, next, scratch);
+        }
+        benchmark::DoNotOptimize(output);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_ClockCycle)->Args({256, 0})->Args({256, 1})->Args({4096, 0})->Args({4096, 1});
+
+/// Measures the multiplication of two vectors of state.range(0) bits.
+static void BM_Mul(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first * second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Mul)->Arg(64)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096)->Arg(16384);
+
+/// Measures the full product of two vectors of state.range(0) bits (v4::mulWrap with twice their width) into a reused destination.
+static void BM_MulFull(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state second = makeKnownVector(state.range(0));
+    vec4state result;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        v4::mulWrap(result, first, second, 2 * state.range(0));
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_MulFull)->Arg(256)->Arg(2048)->Arg(4096)->Arg(16384)->Arg(65536);
+
+/// Measures the division of a vector of state.range(0) bits by a vector of state.range(1) bits.
+static void BM_Div(benchmark::State& state) {
+    vec4state dividend = makeKnownVector(state.range(0));
+    vec4state divisor = makeKnownVector(state.range(1));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = dividend / divisor;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Div)->Args({32, 32})->Args({256, 32})->Args({4096, 32})->Args({4096, 64})->Args({4096, 2048})->Args({4096, 4096})->Args({1024, 512});
+
+/// Measures v4::divmod of a vector of state.range(0) bits by a vector of state.range(1) bits into reused destinations.
+static void BM_Divmod(benchmark::State& state) {
+    vec4state dividend = makeKnownVector(state.range(0));
+    vec4state divisor = makeKnownVector(state.range(1));
+    vec4state quotient, remainder;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        v4::divmod(quotient, remainder, dividend, divisor);
+        benchmark::DoNotOptimize(quotient);
+        benchmark::DoNotOptimize(remainder);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_Divmod)->Args({32, 32})->Args({256, 32})->Args({4096, 32})->Args({4096, 64})->Args({4096, 2048})->Args({4096, 4096})->Args({1024, 512});
+
+/// Measures the part select of state.range(2) bits starting at index state.range(1) of a vector of state.range(0) bits.
+static void BM_GetPartSelect(benchmark::State& state) {
+    vec4state first = makeUnknownVector(state.range(0));
+    long long start = state.range(1);
+    long long end = start + state.range(2) - 1;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first.getPartSelect(end, start);
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_GetPartSelect)->Args({4096, 0, 4})->Args({4096, 2046, 4})->Args({4096, 4094, 4})->Args({4096, 1000, 64})->Args({4096, 1000, 1024})->Args({4096, -2, 4})->Args({65536, 40000, 4});
+
+/// Measures the part select write of state.range(2) bits starting at index state.range(1) of a vector of state.range(0) bits, as in a write into a register file.
+static void BM_SetPartSelect(benchmark::State& state) {
+    vec4state target = makeUnknownVector(state.range(0));
+    vec4state value = makeKnownVector(state.range(2));
+    long long start = state.range(1);
+    long long end = start + state.range(2) - 1;
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        target.setPartSelect(end, start, value);
+        benchmark::DoNotOptimize(target);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_SetPartSelect)->Args({4096, 0, 4})->Args({4096, 2046, 4})->Args({4096, 1000, 64})->Args({4096, 1000, 1024})->Args({65536, 40000, 32});
+
+/// Measures reading and writing every bit of a vector of state.range(0) bits one at a time, as in a scan chain, with getBit and setBit (state.range(1) == 1) or with getBitSelect and setBitSelect (state.range(1) == 0).
+static void BM_BitAccess(benchmark::State& state) {
+    vec4state chain = makeUnknownVector(state.range(0));
+    long long numBits = state.range(0);
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        if (state.range(1)) {
+            logic carry = chain.getBit(numBits - 1);
+            for (long long i = numBits - 1; i > 0; i--) {
+                chain.setBit(i, chain.getBit(i - 1).toBitValue());
+            }
+            chain.setBit(0, carry.toBitValue());
+        } else {
+            vec4state carry = chain.getBitSelect(numBits - 1);
+            for (long long i = numBits - 1; i > 0; i--) {
+                chain.setBitSelect(i, chain.getBitSelect(i - 1));
+            }
+            chain.setBitSelect(0, carry);
+        }
+        benchmark::DoNotOptimize(chain);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+    state.SetItemsProcessed(state.iterations() * numBits);
+}
+BENCHMARK(BM_BitAccess)->Args({64, 0})->Args({64, 1})->Args({1024, 0})->Args({1024, 1});
+
+/// Measures the logical shift left of a vector of state.range(0) bits by an amount that holds an x, as in a reset sequence.
+static void BM_ShiftByUnknown(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    vec4state amount(string("0x1"));
+    for (auto _ : state) {
+        vec4state result = first << amount;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ShiftByUnknown)->Arg(64)->Arg(4096);
+
+/// Measures the logical shift left of a vector of state.range(0) bits by a number of bits that is not a multiple of the limb size.
+static void BM_ShiftLeft(benchmark::State& state) {
+    vec4state first = makeKnownVector(state.range(0));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        vec4state result = first << 13;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK(BM_ShiftLeft)->Arg(64)->Arg(256)->Arg(1024)->Arg(4096);
+
+/// Measures the bitwise AND of two fixed-width vectors of N bits.
+template <long long N>
+static void BM_FixedBitwiseAnd(benchmark::State& state) {
+    vec4state_fixed<N> first(makeKnownVector(N));
+    vec4state_fixed<N> second(makeUnknownVector(N));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first);
+        vec4state_fixed<N> result = first & second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK_TEMPLATE(BM_FixedBitwiseAnd, 8);
+BENCHMARK_TEMPLATE(BM_FixedBitwiseAnd, 16);
+BENCHMARK_TEMPLATE(BM_FixedBitwiseAnd, 32);
+BENCHMARK_TEMPLATE(BM_FixedBitwiseAnd, 64);
+
+/// Measures the addition of two fixed-width vectors of N bits.
+template <long long N>
+static void BM_FixedAdd(benchmark::State& state) {
+    vec4state_fixed<N> first(makeKnownVector(N));
+    vec4state_fixed<N> second(makeKnownVector(N));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first);
+        vec4state_fixed<N> result = first + second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK_TEMPLATE(BM_FixedAdd, 8);
+BENCHMARK_TEMPLATE(BM_FixedAdd, 16);
+BENCHMARK_TEMPLATE(BM_FixedAdd, 32);
+BENCHMARK_TEMPLATE(BM_FixedAdd, 64);
+
+/// Measures the less than relational operator of two fixed-width vectors of N bits.
+template <long long N>
+static void BM_FixedLessThan(benchmark::State& state) {
+    vec4state_fixed<N> first(makeKnownVector(N));
+    vec4state_fixed<N> second(makeKnownVector(N));
+    long long allocationsBefore = allocationCount;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first);
+        vec4state_fixed<1> result = first < second;
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, allocationCount - allocationsBefore);
+}
+BENCHMARK_TEMPLATE(BM_FixedLessThan, 8);
+BENCHMARK_TEMPLATE(BM_FixedLessThan, 16);
+BENCHMARK_TEMPLATE(BM_FixedLessThan, 32);
+BENCHMARK_TEMPLATE(BM_FixedLessThan, 64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,245 @@
+/**
+ * @file limb.h
+ * @brief Declaration and implementation of the limb type of the vec4state class.
+ *
+ * This file contains the limb type, which is the word that vec4state stores its aval and bval planes in, and the helper functions for the carry chains, products and quotients of the arithmetic operators. A limb is 64 bits wide by default, and can be set to 32 bits by defining VEC4STATE_LIMB_BITS to 32 before including this file (e.g. for comparing the two layouts).
+ *
+ * @author Mia Ekheizer, Yuval Shasha
+ * @date 2026-10-16
+ */
+
+#ifndef LIMB_H
+#define LIMB_H
+
+#include <stdint.h>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+#if (defined(_MSC_VER) && defined(_M_X64)) || ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))
+/**
+ * @brief Defined if the add-with-carry and subtract-with-borrow intrinsics of 64-bit words (_addcarry_u64 and _subborrow_u64) are available.
+ */
+#define LIMB_HAS_CARRY_INTRINSICS_64
+#endif
+
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || ((defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)))
+/**
+ * @brief Defined if the add-with-carry and subtract-with-borrow intrinsics of 32-bit words (_addcarry_u32 and _subborrow_u32) are available.
+ */
+#define LIMB_HAS_CARRY_INTRINSICS_32
+#endif
+
+#ifndef VEC4STATE_LIMB_BITS
+/**
+ * @brief The number of bits in a limb, either 32 or 64.
+ */
+#define VEC4STATE_LIMB_BITS 64
+#endif
+
+#if VEC4STATE_LIMB_BITS == 64
+/**
+ * @brief The word that holds 64 bits of the aval or bval plane of a vector.
+ */
+typedef uint64_t limb_t;
+#elif VEC4STATE_LIMB_BITS == 32
+/**
+ * @brief The word that holds 32 bits of the aval or bval plane of a vector.
+ */
+typedef uint32_t limb_t;
+#else
+#error "VEC4STATE_LIMB_BITS must be either 32 or 64"
+#endif
+
+/**
+ * @brief The number of bits in a limb.
+ */
+#define BITS_IN_LIMB VEC4STATE_LIMB_BITS
+
+/**
+ * @brief A mask for all the bits in a limb.
+ */
+#define MASK_LIMB (~limb_t(0))
+
+/**
+ * @brief Adds two limbs and a carry.
+ *
+ * Calculates a + b + carryIn, and sets carryOut to the carry out of the limb. Uses the add-with-carry intrinsic where it is available.
+ *
+ * @param a The first limb to add.
+ * @param b The second limb to add.
+ * @param carryIn The carry into the addition, must be 0 or 1.
+ * @param carryOut Set to the carry out of the addition (0 or 1).
+ * @return The lower BITS_IN_LIMB bits of the sum.
+ */
+inline limb_t addWithCarry(limb_t a, limb_t b, limb_t carryIn, limb_t& carryOut) {
+#if VEC4STATE_LIMB_BITS == 64 && defined(LIMB_HAS_CARRY_INTRINSICS_64)
+    unsigned long long sum;
+    carryOut = _addcarry_u64((unsigned char)(carryIn), a, b, &sum);
+    return sum;
+#elif VEC4STATE_LIMB_BITS == 32 && defined(LIMB_HAS_CARRY_INTRINSICS_32)
+    unsigned int sum;
+    carryOut = _addcarry_u32((unsigned char)(carryIn), a, b, &sum);
+    return sum;
+#else
+    limb_t sum = a + b;
+    limb_t carry = limb_t(sum < a);
+    sum += carryIn;
+    carryOut = carry | limb_t(sum < carryIn);
+    return sum;
+#endif
+}
+
+/**
+ * @brief Subtracts a limb and a borrow from a limb.
+ *
+ * Calculates a - b - borrowIn, and sets borrowOut to the borrow out of the limb. Uses the subtract-with-borrow intrinsic where it is available.
+ *
+ * @param a The limb to subtract from.
+ * @param b The limb to subtract.
+ * @param borrowIn The borrow into the subtraction, must be 0 or 1.
+ * @param borrowOut Set to the borrow out of the subtraction (0 or 1).
+ * @return The lower BITS_IN_LIMB bits of the difference.
+ */
+inline limb_t subWithBorrow(limb_t a, limb_t b, limb_t borrowIn, limb_t& borrowOut) {
+#if VEC4STATE_LIMB_BITS == 64 && defined(LIMB_HAS_CARRY_INTRINSICS_64)
+    unsigned long long difference;
+    borrowOut = _subborrow_u64((unsigned char)(borrowIn), a, b, &difference);
+    return difference;
+#elif VEC4STATE_LIMB_BITS == 32 && defined(LIMB_HAS_CARRY_INTRINSICS_32)
+    unsigned int difference;
+    borrowOut = _subborrow_u32((unsigned char)(borrowIn), a, b, &difference);
+    return difference;
+#else
+    limb_t difference = a - b;
+    limb_t borrow = limb_t(a < b);
+    borrowOut = borrow | limb_t(difference < borrowIn);
+    return difference - borrowIn;
+#endif
+}
+
+/**
+ * @brief Multiplies two limbs into a double limb product.
+ *
+ * Calculates the full product of a and b, using a 128-bit multiplication for 64-bit limbs where it is available.
+ *
+ * @param a The first limb to multiply.
+ * @param b The second limb to multiply.
+ * @param high Set to the upper BITS_IN_LIMB bits of the product.
+ * @return The lower BITS_IN_LIMB bits of the product.
+ */
+inline limb_t mulWide(limb_t a, limb_t b, limb_t& high) {
+#if VEC4STATE_LIMB_BITS == 32
+    uint64_t product = uint64_t(a) * uint64_t(b);
+    high = limb_t(product >> 32);
+    return limb_t(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long long productHigh;
+    unsigned long long productLow = _umul128(a, b, &productHigh);
+    high = productHigh;
+    return productLow;
+#elif defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)(a) * b;
+    high = limb_t(product >> 64);
+    return limb_t(product);
+#else
+    // Multiply the 32-bit halves and combine the partial products.
+    uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+    high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return (middle << 32) | (lowLow & 0xFFFFFFFF);
+#endif
+}
+
+/**
+ * @brief Counts the leading zero bits of a limb.
+ *
+ * Uses the bit scan intrinsic where it is available.
+ *
+ * @param limb The limb to count the leading zeros of, must not be 0.
+ * @return The number of zero bits above the most significant 1 bit of limb.
+ */
+inline int countLeadingZeros(limb_t limb) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, limb);
+    return BITS_IN_LIMB - 1 - int(index);
+#elif defined(__GNUC__)
+    return __builtin_clzll(limb) - (64 - BITS_IN_LIMB);
+#else
+    int count = 0;
+    while (!(limb >> (BITS_IN_LIMB - 1))) {
+        limb <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Divides a double limb by a limb.
+ *
+ * Calculates the quotient and the remainder of (high * 2^BITS_IN_LIMB + low) / divisor, where high must be less than divisor, so that the quotient fits in a limb. Uses a 128-bit division for 64-bit limbs where it is available, and otherwise divides by the 32-bit halves of the normalized divisor.
+ *
+ * @param high The upper limb of the dividend, must be less than divisor.
+ * @param low The lower limb of the dividend.
+ * @param divisor The limb to divide by, must not be 0.
+ * @param remainder Set to the remainder of the division.
+ * @return The quotient of the division.
+ */
+inline limb_t divWide(limb_t high, limb_t low, limb_t divisor, limb_t& remainder) {
+#if VEC4STATE_LIMB_BITS == 32
+    uint64_t dividend = (uint64_t(high) << 32) | low;
+    remainder = limb_t(dividend % divisor);
+    return limb_t(dividend / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1923
+    unsigned long long divisionRemainder;
+    unsigned long long quotient = _udiv128(high, low, divisor, &divisionRemainder);
+    remainder = divisionRemainder;
+    return quotient;
+#elif defined(__SIZEOF_INT128__)
+    unsigned __int128 dividend = ((unsigned __int128)(high) << 64) | low;
+    remainder = limb_t(dividend % divisor);
+    return limb_t(dividend / divisor);
+#else
+    // Normalize the divisor so that its most significant bit is set, and calculate each 32-bit half of the quotient from an estimate that is too large by at most 2.
+    const uint64_t halfBase = uint64_t(1) << 32;
+    int shift = countLeadingZeros(divisor);
+    divisor <<= shift;
+    uint64_t divisorHigh = divisor >> 32;
+    uint64_t divisorLow = divisor & 0xFFFFFFFF;
+    uint64_t dividendTop = (high << shift) | (shift != 0 ? low >> (64 - shift) : 0);
+    uint64_t dividendBottom = low << shift;
+    uint64_t dividendHighHalf = dividendBottom >> 32;
+    uint64_t dividendLowHalf = dividendBottom & 0xFFFFFFFF;
+    uint64_t quotientHigh = dividendTop / divisorHigh;
+    uint64_t partialRemainder = dividendTop - quotientHigh * divisorHigh;
+    while (quotientHigh >= halfBase || quotientHigh * divisorLow > halfBase * partialRemainder + dividendHighHalf) {
+        quotientHigh--;
+        partialRemainder += divisorHigh;
+        if (partialRemainder >= halfBase) {
+            break;
+        }
+    }
+    uint64_t dividendMiddle = dividendTop * halfBase + dividendHighHalf - quotientHigh * divisor;
+    uint64_t quotientLow = dividendMiddle / divisorHigh;
+    partialRemainder = dividendMiddle - quotientLow * divisorHigh;
+    while (quotientLow >= halfBase || quotientLow * divisorLow > halfBase * partialRemainder + dividendLowHalf) {
+        quotientLow--;
+        partialRemainder += divisorHigh;
+        if (partialRemainder >= halfBase) {
+            break;
+        }
+    }
+    remainder = (dividendMiddle * halfBase + dividendLowHalf - quotientLow * divisor) >> shift;
+    return quotientHigh * halfBase + quotientLow;
+#endif
+}
+
+#endif
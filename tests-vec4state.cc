@@ -10,7 +10,54 @@
 
 #include <gtest/gtest.h>
 #include "vec4state.h"
+#include "vec4stateFixed.h"
+#include "vec4stateExpr.h"
+#include <cstdlib>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#include <new>
 #include <string>
+#include <vector>
+
+/**
+ * @brief The number of planes allocated on the heap since the start of the program.
+ * 
+ * The planes of a vector are the only memory that vec4state allocates with an alignment, so the aligned allocation functions are replaced to count them.
+ */
+static long long planeAllocationCount = 0;
+
+void* operator new(size_t size, align_val_t alignment) {
+    planeAllocationCount++;
+#ifdef _MSC_VER
+    void* ptr = _aligned_malloc(size == 0 ? 1 : size, size_t(alignment));
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    size_t alignedSize = (size + size_t(alignment) - 1) / size_t(alignment) * size_t(alignment);
+    void* ptr = aligned_alloc(size_t(alignment), alignedSize == 0 ? size_t(alignment) : alignedSize);
+#endif
+    if (ptr == nullptr) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+/// Frees memory that was allocated by the aligned operator new.
+void freeAligned(void* ptr) {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, size_t, align_val_t) noexcept {
+    freeAligned(ptr);
+}
 
 /**
  * @class vec4stateTest
@@ -141,6 +188,21 @@ testing::AssertionResult checkVectorSize(vec4state& vector, long long size) {
     }
 }
 
+/// Creates a known vector of numBits pseudo-random bits, drawn from a linear congruential generator that advances the given seed.
+vec4state makePattern(long long numBits, unsigned int& seed) {
+    string bits;
+    for (long long i = 0; i < numBits; i++) {
+        seed = seed * 1103515245 + 12345;
+        bits += ((seed >> 16) & 1) ? ONE : ZERO;
+    }
+    return vec4state(bits);
+}
+
+/// Creates the bit strings of the operands that are paired with each other in the tests that compare two ways of calculating an operator: vectors of one limb and of several limbs, with and without unknown bits, and with equal and different sizes.
+vector<string> makeOperandBitStrings() {
+    return {"1", "1xz0", "10x1z0", string(70, ONE), string(30, Z) + string(40, ZERO) + "1x", "10" + string(98, ZERO) + "1xz01", string(65, ONE) + "z" + string(64, ZERO), string(64, ONE) + string(64, ZERO) + "1", string(130, ZERO) + "1", string(130, ONE) + "01"};
+}
+
 /// Checks that the default constructor creates a 1-bit vector that stores the value x.
 TEST_F(vec4stateTest, TestDefaultConstructor) {
     vec4state testVector;
@@ -163,6 +225,18 @@ TEST_F(vec4stateTest, TestLongLongConstructor) {
     EXPECT_TRUE(checkVectorSize(testVector, 64));
 }
 
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+/// Checks that the constructor creates a 128-bit vector that stores every limb of an integer wider than 64 bits, including the sign bits of a negative one.
+TEST_F(vec4stateTest, TestWideIntegerConstructor) {
+    vec4state testVector((__int128(1) << 100) | 5);
+    EXPECT_TRUE(compareVectorToString(testVector, string(27, ZERO) + char(ONE) + string(97, ZERO) + "101"));
+    EXPECT_TRUE(checkVectorSize(testVector, 128));
+    vec4state negativeVector(-(__int128(1) << 70));
+    EXPECT_TRUE(compareVectorToString(negativeVector, string(58, ONE) + string(70, ZERO)));
+    EXPECT_TRUE(checkVectorSize(negativeVector, 128));
+}
+#endif
+
 /// Checks that the constructor creates a 32-bit vector that stores the value of the negative integer passed to it (only 1 bits).
 TEST_F(vec4stateTest, TestSignedConstructor) {
     vec4state testVector(-1);
@@ -185,6 +259,160 @@ TEST_F(vec4stateTest, TestStringConstructor) {
     EXPECT_TRUE(checkVectorSize(hundredAndEightBitVector, 108));
 }
 
+/// Checks that the fill constructor creates a vector of the given number of bits that holds the given bit in every position, for vectors that end inside a limb and on a limb boundary, and that it throws on a non-positive number of bits or an invalid bit.
+TEST_F(vec4stateTest, TestFillConstructor) {
+    for (long long numBits : {1LL, 31LL, 32LL, 64LL, 65LL, 1000LL}) {
+        for (BitValue bit : {ZERO, ONE, X, Z}) {
+            vec4state filledVector(bit, numBits);
+            EXPECT_TRUE(compareVectorToString(filledVector, string(numBits, bit)));
+            EXPECT_TRUE(checkVectorSize(filledVector, numBits));
+            EXPECT_EQ(filledVector.isUnknown(), bit == X || bit == Z);
+        }
+    }
+    EXPECT_THROW(vec4state(ONE, 0), vec4stateExceptionInvalidSize);
+    EXPECT_THROW(vec4state(ONE, -5), vec4stateExceptionInvalidSize);
+    EXPECT_THROW(vec4state(BitValue('2'), 8), vec4stateExceptionInvalidInput);
+    vec4state zeroBit('0');
+    EXPECT_FALSE(zeroBit.isUnknown());
+}
+
+/// Checks that fill sets every bit of the vector to the given bit and keeps its number of bits, that it doesn't change a copy that shares the planes of the vector, and that an invalid bit leaves the vector unchanged.
+TEST_F(vec4stateTest, TestFill) {
+    vec4state filledVector(string(70, ONE) + "x0");
+    vec4state copy = filledVector;
+    filledVector.fill(Z);
+    EXPECT_TRUE(compareVectorToString(filledVector, string(72, 'z')));
+    EXPECT_TRUE(checkVectorSize(filledVector, 72));
+    EXPECT_TRUE(filledVector.isUnknown());
+    EXPECT_TRUE(compareVectorToString(copy, string(70, '1') + "x0"));
+    filledVector.fill(ONE);
+    EXPECT_TRUE(compareVectorToString(filledVector, string(72, '1')));
+    EXPECT_FALSE(filledVector.isUnknown());
+    EXPECT_THROW(filledVector.fill(BitValue('a')), vec4stateExceptionInvalidInput);
+    EXPECT_TRUE(compareVectorToString(filledVector, string(72, '1')));
+}
+
+/// Checks that the string constructor parses strings that span several limbs, with and without a partial last limb, and that an invalid character is reported with its index.
+TEST_F(vec4stateTest, TestStringConstructorAcrossLimbs) {
+    const char bitValues[] = {ZERO, ONE, X, Z};
+    for (long long length : {31LL, 32LL, 63LL, 64LL, 65LL, 200LL, 1000LL}) {
+        string bits;
+        for (long long i = 0; i < length; i++) {
+            bits += bitValues[(i * 7 + i / 3) % 4];
+        }
+        vec4state parsedVector(bits);
+        EXPECT_TRUE(compareVectorToString(parsedVector, bits));
+        EXPECT_TRUE(checkVectorSize(parsedVector, length));
+        EXPECT_TRUE(parsedVector.isUnknown());
+        vec4state knownVector(string(length - 1, ONE) + "0");
+        EXPECT_FALSE(knownVector.isUnknown());
+    }
+    for (long long invalidIndex : {0LL, 5LL, 70LL, 150LL, 199LL}) {
+        string bits(200, ONE);
+        bits[invalidIndex] = 'X';
+        try {
+            vec4state invalidVector(bits);
+            ADD_FAILURE();
+        } catch (vec4stateExceptionInvalidInput& e) {
+            EXPECT_NE(string(e.what()).find("at index " + to_string(invalidIndex)), string::npos);
+        }
+    }
+}
+
+/// Checks that fromLiteral parses sized, unsized and unbased literals in every base with x, z and ? digits and underscores, truncates and extends them to their size, and throws on malformed literals.
+TEST_F(vec4stateTest, TestFromLiteral) {
+    vec4state hexLiteral = vec4state::fromLiteral("8'hFF");
+    EXPECT_TRUE(compareVectorToString(hexLiteral, "11111111"));
+    EXPECT_FALSE(hexLiteral.isUnknown());
+    vec4state binaryLiteral = vec4state::fromLiteral("16'b1x0z");
+    EXPECT_TRUE(compareVectorToString(binaryLiteral, string(12, '0') + "1x0z"));
+    EXPECT_TRUE(binaryLiteral.isUnknown());
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("8'bx1"), "xxxxxxx1"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("6'hz"), "zzzzzz"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("12'o7_?x"), "000111zzzxxx"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("4'hABC"), "1100"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("4'sd5"), "0101"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("4 'D 9"), "1001"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'d123"), string(25, '0') + "1111011"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("123"), string(25, '0') + "1111011"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'hx"), string(32, 'x')));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("8'dz"), "zzzzzzzz"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'1"), "1"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'x"), "x"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'z"), "z"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("'b" + string(40, '1')), string(40, '1')));
+    // An octal digit that crosses a limb boundary.
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("70'o" + string(23, '7') + "4"), string(67, '1') + "100"));
+    EXPECT_TRUE(compareVectorToString(vec4state::fromLiteral("66'hx" + string(16, 'f')), "xx" + string(64, '1')));
+    EXPECT_EQ(vec4state::fromLiteral("100'd1_000_000_000_000_000_000_000_000_000").toString(10), "1" + string(27, '0'));
+    EXPECT_EQ(vec4state::fromLiteral("340282366920938463463374607431768211455").toString(), string(128, '1'));
+    EXPECT_EQ(vec4state::fromLiteral("1" + string(60, '0')).toString(10), "1" + string(60, '0'));
+    EXPECT_THROW(vec4state::fromLiteral(""), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'h"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'q1"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'b102"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'h_F"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("8'd1x"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("12a"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("'2"), vec4stateExceptionInvalidInput);
+    EXPECT_THROW(vec4state::fromLiteral("0'h1"), vec4stateExceptionInvalidSize);
+    EXPECT_THROW(vec4state::fromLiteral("99999999999'h1"), vec4stateExceptionInvalidSize);
+}
+
+/// Checks that toString and toChars return the bits of the vector for every number of bits that is not a multiple of 8 and across limbs, and that toChars reports a buffer that is too small without writing beyond it.
+TEST_F(vec4stateTest, TestToStringAndToChars) {
+    const char bitValues[] = {ZERO, ONE, X, Z};
+    for (long long length = 1; length <= 140; length++) {
+        string bits;
+        for (long long i = 0; i < length; i++) {
+            bits += bitValues[(i * 5 + i / 4) % 4];
+        }
+        vec4state bitsVector(bits);
+        EXPECT_EQ(bitsVector.toString(), bits);
+        char buf[160];
+        to_chars_result result = bitsVector.toChars(buf, sizeof(buf));
+        EXPECT_EQ(result.ec, errc());
+        EXPECT_EQ(result.ptr, buf + length);
+        EXPECT_EQ(string(buf, result.ptr), bits);
+    }
+    vec4state wideVector(string(100, ONE));
+    char smallBuf[100];
+    to_chars_result result = wideVector.toChars(smallBuf, 99);
+    EXPECT_EQ(result.ec, errc::value_too_large);
+    EXPECT_EQ(result.ptr, smallBuf + 99);
+    result = wideVector.toChars(smallBuf, 100);
+    EXPECT_EQ(result.ec, errc());
+    EXPECT_EQ(string(smallBuf, 100), string(100, ONE));
+}
+
+/// Checks that toString with a radix writes octal and hexadecimal digits with x, z, X and Z for unknown digits as SystemVerilog $display does, writes wide decimal values, and throws on an invalid radix.
+TEST_F(vec4stateTest, TestToStringRadix) {
+    vec4state hexVector("1010xxxxzzzz01x10zz1xxzz");
+    EXPECT_EQ(hexVector.toString(16), "axzXZX");
+    EXPECT_EQ(hexVector.toString(2), hexVector.toString());
+    EXPECT_EQ(vec4state("z1010").toString(8), "Z2");
+    EXPECT_EQ(vec4state("zz111000").toString(8), "z70");
+    EXPECT_EQ(vec4state(string(64, ONE) + "1").toString(8), "3" + string(21, '7'));
+    EXPECT_EQ(vec4state(int16_t(-1)).toString(16), "ffff");
+    EXPECT_EQ(vec4state(int16_t(-1)).toString(10), "65535");
+    EXPECT_EQ(vec4state(-1LL).toString(10), "18446744073709551615");
+    EXPECT_EQ(vec4state(string(100, ZERO)).toString(10), "0");
+    EXPECT_EQ(vec4state("1x").toString(10), "X");
+    EXPECT_EQ(vec4state("xx").toString(10), "x");
+    EXPECT_EQ(vec4state("zz").toString(10), "z");
+    EXPECT_EQ(vec4state("z1").toString(10), "Z");
+    EXPECT_EQ(vec4state("xz").toString(10), "X");
+    vec4state power(string(999, ZERO) + "1");
+    for (int i = 0; i < 300; i++) {
+        power = power * vec4state(10);
+    }
+    EXPECT_EQ(power.toString(10), "1" + string(300, '0'));
+    EXPECT_EQ((power - vec4state(1)).toString(10), string(300, '9'));
+    EXPECT_EQ((power + power).toString(10), "2" + string(300, '0'));
+    EXPECT_THROW(power.toString(3), vec4stateExceptionInvalidInput);
+}
+
 /// Checks that the copy constructor creates a vector that has the same value and number of bits as the vector passed to it.
 TEST_F(vec4stateTest, TestCopyConstructor) {
     vec4state copyVector = stringVector;
@@ -192,6 +420,33 @@ TEST_F(vec4stateTest, TestCopyConstructor) {
     EXPECT_TRUE(checkVectorSize(copyVector, 6));
 }
 
+/// Checks that copies of a vector on the heap share its planes, and that each mutating method clones the planes before changing them, leaving the other copies unchanged.
+TEST_F(vec4stateTest, TestCopyOnWrite) {
+    string bits = string(100, '1') + string(100, 'z');
+    vec4state original(bits);
+    vec4state copyVector = original;
+    EXPECT_EQ(copyVector.getAvalPlane(), original.getAvalPlane());
+    copyVector.setBitSelect(vec4state(0), vec4state(ZERO));
+    EXPECT_NE(copyVector.getAvalPlane(), original.getAvalPlane());
+    EXPECT_TRUE(compareVectorToString(copyVector, string(100, '1') + string(99, 'z') + "0"));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+    vec4state partVector = original;
+    partVector.setPartSelect(199, 100, vec4state(0));
+    EXPECT_TRUE(compareVectorToString(partVector, string(100, '0') + string(100, 'z')));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+    vec4state twoStateVector = original;
+    twoStateVector.convertTo2State();
+    EXPECT_TRUE(compareVectorToString(twoStateVector, string(100, '1') + string(100, '0')));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+    vec4state assignedVector(string(200, '0'));
+    assignedVector = original;
+    EXPECT_EQ(assignedVector.getAvalPlane(), original.getAvalPlane());
+    vec4state shiftedVector = original << 1;
+    EXPECT_TRUE(compareVectorToString(shiftedVector, string(99, '1') + string(100, 'z') + "0"));
+    EXPECT_TRUE(compareVectorToString(~original, string(100, '0') + string(100, 'x')));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+}
+
 /// Checks that the move constructor transfers the ownership of the original vector's resources to the destination vector.
 TEST_F(vec4stateTest, TestMoveConstructor) {
     EXPECT_TRUE(compareVectorToString(stringVector, string("01xz11")));
@@ -201,6 +456,46 @@ TEST_F(vec4stateTest, TestMoveConstructor) {
     EXPECT_TRUE(checkVectorSize(moveVector, 6));
 }
 
+/// Checks that the aval and bval planes of a vector on the heap are contiguous and aligned, and that getVector materializes the same values as 32-bit VPI elements.
+TEST_F(vec4stateTest, TestAvalBvalPlanes) {
+    vec4state vector = vec4state(string(300, 'z')) << 10;
+    const limb_t* avalPlane = vector.getAvalPlane();
+    const limb_t* bvalPlane = vector.getBvalPlane();
+    long long lastLimb = (300 + BITS_IN_LIMB - 1) / BITS_IN_LIMB - 1;
+    EXPECT_EQ(vector.getNumLimbs(), lastLimb + 1);
+    EXPECT_EQ(vector.getVectorSize(), 10);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(avalPlane) % PLANE_ALIGNMENT, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(bvalPlane) % PLANE_ALIGNMENT, 0);
+    EXPECT_EQ(avalPlane[0], MASK_LIMB << 10);
+    EXPECT_EQ(bvalPlane[0], MASK_LIMB << 10);
+    EXPECT_EQ(avalPlane[lastLimb], MASK_LIMB >> (BITS_IN_LIMB - 300 % BITS_IN_LIMB));
+    shared_ptr<VPI[]> vpiVector = vector.getVector();
+    for (long long i = 0; i < vector.getVectorSize(); i++) {
+        long long limbIndex = i * BITS_IN_VPI / BITS_IN_LIMB;
+        long long shift = i * BITS_IN_VPI % BITS_IN_LIMB;
+        EXPECT_EQ(vpiVector[i].getAval(), uint32_t(avalPlane[limbIndex] >> shift));
+        EXPECT_EQ(vpiVector[i].getBval(), uint32_t(bvalPlane[limbIndex] >> shift));
+    }
+    EXPECT_EQ(vpiVector[0].getAval(), 0xFFFFFC00u);
+    EXPECT_EQ(vpiVector[9].getAval(), 0xFFFu);
+}
+
+/// Checks that the arithmetic operators carry and borrow across limbs, and that the integral constructor keeps only the bits of its type.
+TEST_F(vec4stateTest, TestArithmeticAcrossLimbs) {
+    vec4state allOnes = vec4state(string(100, ONE));
+    vec4state sum = allOnes + vec4state(1);
+    EXPECT_TRUE(compareVectorToString(sum, "1" + string(100, '0')));
+    EXPECT_TRUE(checkVectorSize(sum, 101));
+    vec4state difference = vec4state(string(100, ZERO)) - vec4state(1);
+    EXPECT_TRUE(compareVectorToString(difference, string(100, '1')));
+    vec4state product = vec4state(0xFFFFFFFFFFFFFFFFull) * vec4state(0xFFFFFFFFFFFFFFFFull);
+    EXPECT_TRUE(compareVectorToString(product, string(63, '0') + "1"));
+    vec4state wideProduct = (vec4state(string(128, ZERO)) + vec4state(0xFFFFFFFFFFFFFFFFull)) * vec4state(0xFFFFFFFFFFFFFFFFull);
+    EXPECT_TRUE(compareVectorToString(wideProduct, string(63, '1') + "0" + string(63, '0') + "1"));
+    EXPECT_TRUE(compareVectorToString(vec4state(int16_t(-1)), string(16, '1')));
+    EXPECT_TRUE(compareVectorToString(vec4state(-2), string(31, '1') + "0"));
+}
+
 /// Checks that the assignment operator from another vector changes the destination vector to hold the same values as the vector assigned to it.
 TEST_F(vec4stateTest, TestAssignmentFromVector) {
     vec4state copy("0101xx");
@@ -315,6 +610,17 @@ TEST_F(vec4stateTest, TestBitwiseAndSmallVectorWithBigVector) {
     EXPECT_TRUE(checkVectorSize(andVector, 108));
 }
 
+/// Checks that the bitwise AND operator covers every combination of 4-state bits, and that the bits of the longer vector that are beyond the shorter vector become 0 (regardless of the order of the operands).
+TEST_F(vec4stateTest, TestBitwiseAndAllBitCombinations) {
+    vec4state first("zzzz" + string(96, '1') + "01xz01xz01xz01xz");
+    vec4state second("1111000011110000");
+    string expected = string(100, '0') + "01xx000001xx0000";
+    EXPECT_TRUE(compareVectorToString(first & second, expected));
+    EXPECT_TRUE(compareVectorToString(second & first, expected));
+    EXPECT_TRUE(checkVectorSize(first & second, 116));
+    EXPECT_TRUE((first & second).isUnknown());
+}
+
 /// Checks that the bitwise OR operator between a vector that holds an integer with itself creates the same vector.
 TEST_F(vec4stateTest, TestBitwiseOrIntVectorWithItself) {
     vec4state orVector = intVector | intVector;
@@ -427,6 +733,35 @@ TEST_F(vec4stateTest, TestBitwiseXorSmallVectorWithBigVector) {
     EXPECT_TRUE(checkVectorSize(xorVector, 108));
 }
 
+/// Checks that the bitwise XOR operator covers every combination of 4-state bits, and that the bits of the longer vector that are beyond the shorter vector are XORed with 0's.
+TEST_F(vec4stateTest, TestBitwiseXorAllBitCombinations) {
+    vec4state first("10z01xz01xz01xz01xz");
+    vec4state second("00001111xxxxzzzz");
+    string expected = "10x01xx10xxxxxxxxxx";
+    EXPECT_TRUE(compareVectorToString(first ^ second, expected));
+    EXPECT_TRUE(compareVectorToString(second ^ first, expected));
+    EXPECT_TRUE(checkVectorSize(first ^ second, 19));
+}
+
+/// Checks that the bitwise XNOR operator covers every combination of 4-state bits, that it is symmetric, and that the bits that are out of range stay 0.
+TEST_F(vec4stateTest, TestBitwiseXnorAllBitCombinations) {
+    vec4state first("10z01xz01xz01xz01xz");
+    vec4state second("00001111xxxxzzzz");
+    string expected = "01x10xx01xxxxxxxxxx";
+    EXPECT_TRUE(compareVectorToString(first.xnor(second), expected));
+    EXPECT_TRUE(compareVectorToString(second.xnor(first), expected));
+    EXPECT_TRUE(checkVectorSize(first.xnor(second), 19));
+    EXPECT_TRUE(first.xnor(second).caseEquality(vec4state(expected)));
+}
+
+/// Checks that the bitwise XNOR operator between a vector and an integer is the bitwise NOT of their XOR when both are known.
+TEST_F(vec4stateTest, TestBitwiseXnorIntVectorWithInteger) {
+    vec4state xnorVector = intVector.xnor(0x0F0F0F0F);
+    EXPECT_TRUE(compareVectorToString(xnorVector, (~(intVector ^ 0x0F0F0F0F)).toString()));
+    EXPECT_TRUE(compareVectorToString(intVector.xnor(intVector), string(32, '1')));
+    EXPECT_FALSE(xnorVector.isUnknown());
+}
+
 /// Checks that the bitwise NOT operator on a vector that holds a long long number creates a vector that holds the bitwise NOT of the number.
 TEST_F(vec4stateTest, TestBitwiseNotLongLongVector) {
     vec4state notVector = ~longLongVector;
@@ -565,6 +900,31 @@ TEST_F(vec4stateTest, TestZeroesVectorEqualityWithZThenZeroesVector) {
     EXPECT_TRUE(checkVectorSize(eqVector, 1));
 }
 
+/// Checks that the result of logical equality between vectors of different sizes compares the missing high bits of the shorter vector to 0's, and that the inequality returns the negated result.
+TEST_F(vec4stateTest, TestEqualityDifferentSizesAcrossLimbs) {
+    vec4state shortVector = vec4state("1x01");
+    vec4state longVector = vec4state(string(196, ZERO) + "1x01");
+    vec4state eqVector = shortVector == longVector;
+    EXPECT_TRUE(compareVectorToString(eqVector, string("x")));
+    EXPECT_TRUE(compareVectorToString(shortVector != longVector, string("x")));
+    vec4state highOneVector = vec4state("1" + string(195, ZERO) + "1x01");
+    EXPECT_FALSE(shortVector == highOneVector);
+    EXPECT_TRUE(highOneVector != shortVector);
+    vec4state highXVector = vec4state("x" + string(195, ZERO) + "0101");
+    EXPECT_TRUE(compareVectorToString(vec4state("0101") == highXVector, string("x")));
+}
+
+/// Checks that a known bit that is different decides the logical equality even if the vectors hold unknown bits in other limbs.
+TEST_F(vec4stateTest, TestEqualityKnownMismatchWithUnknownBits) {
+    vec4state first = vec4state(string(100, X) + string(99, ONE) + "0");
+    vec4state second = vec4state(string(100, Z) + string(100, ONE));
+    EXPECT_FALSE(first == second);
+    EXPECT_TRUE(first != second);
+    vec4state third = vec4state("0" + string(99, Z) + string(100, ONE));
+    EXPECT_TRUE(compareVectorToString(second == third, string("x")));
+    EXPECT_TRUE(compareVectorToString(second != third, string("x")));
+}
+
 /// Checks that the result of logical inequality between a vector that holds an integer and itself is false.
 TEST_F(vec4stateTest, TestIntVectorInequalityWithItself) {
     EXPECT_FALSE(intVector != intVector);
@@ -887,6 +1247,74 @@ TEST_F(vec4stateTest, TestGetUnknownBitSelectIntVector) {
     EXPECT_TRUE(checkVectorSize(indexVector, 32));
 }
 
+/// Checks that tryToUint64 converts known vectors of up to 64 bits (and wider vectors whose upper bits are 0) to numbers, and returns a status without changing the value for unknown and too large vectors.
+TEST_F(vec4stateTest, TestTryToUint64) {
+    uint64_t value = 7;
+    EXPECT_EQ(vec4state(0x12345678).tryToUint64(value), NUMBER_OK);
+    EXPECT_EQ(value, 0x12345678u);
+    EXPECT_EQ(vec4state(-1LL).tryToUint64(value), NUMBER_OK);
+    EXPECT_EQ(value, UINT64_MAX);
+    EXPECT_EQ(vec4state(string(100, ZERO) + "101").tryToUint64(value), NUMBER_OK);
+    EXPECT_EQ(value, 5u);
+    EXPECT_EQ(vec4state(string("1x")).tryToUint64(value), NUMBER_UNKNOWN);
+    EXPECT_EQ(value, 5u);
+    EXPECT_EQ(vec4state("1" + string(64, ZERO)).tryToUint64(value), NUMBER_TOO_LARGE);
+    EXPECT_EQ(vec4state("1" + string(63, ZERO) + "x").tryToUint64(value), NUMBER_TOO_LARGE);
+    EXPECT_EQ(value, 5u);
+    // Shifts and bit selects by unknown or too large amounts give the same results as before.
+    vec4state wideVector(string(70, ONE));
+    EXPECT_TRUE(compareVectorToString(wideVector << vec4state(string("x1")), string(70, X)));
+    EXPECT_TRUE(compareVectorToString(wideVector >> vec4state("1" + string(64, ZERO)), string(70, ZERO)));
+    vec4state shiftedVector = wideVector;
+    shiftedVector >>= vec4state(string("z"));
+    EXPECT_TRUE(compareVectorToString(shiftedVector, string(70, X)));
+    shiftedVector = wideVector;
+    shiftedVector <<= vec4state(3);
+    EXPECT_TRUE(compareVectorToString(shiftedVector, string(67, ONE) + "000"));
+    wideVector.setBitSelect(vec4state(string("x")), vec4state(ZERO));
+    wideVector.setBitSelect(vec4state("1" + string(64, ZERO)), vec4state(ZERO));
+    EXPECT_TRUE(compareVectorToString(wideVector, string(70, ONE)));
+}
+
+/// Checks that getBit reads every bit of a wide vector as a logic that matches the string representation of the vector, and reads out of range bits as x.
+TEST_F(vec4stateTest, TestGetBit) {
+    string bits = "1xz0" + string(96, ONE) + "z";
+    vec4state wideVector(bits);
+    for (long long i = 0; i < 101; i++) {
+        EXPECT_EQ(wideVector.getBit(i).toBitValue(), BitValue(bits[size_t(100 - i)]));
+    }
+    EXPECT_EQ(wideVector.getBit(0), logic(Z));
+    EXPECT_EQ(wideVector.getBit(99), logic(X));
+    EXPECT_TRUE(wideVector.getBit(98).isUnknown());
+    EXPECT_FALSE(wideVector.getBit(100).isUnknown());
+    EXPECT_EQ(wideVector.getBit(101), logic(X));
+    EXPECT_EQ(wideVector.getBit(-1), logic(X));
+    EXPECT_EQ(logic(true, true).toBitValue(), Z);
+    EXPECT_EQ(logic(false, true).toBitValue(), X);
+    EXPECT_EQ(logic().toBitValue(), ZERO);
+}
+
+/// Checks that setBit writes single bits of a wide vector, keeps the unknown flag up to date, ignores out of range indices, clones shared planes, and throws on an invalid bit.
+TEST_F(vec4stateTest, TestSetBit) {
+    vec4state wideVector(string(100, ZERO));
+    vec4state copyVector = wideVector;
+    wideVector.setBit(64, ONE);
+    wideVector.setBit(63, Z);
+    wideVector.setBit(0, X);
+    EXPECT_TRUE(compareVectorToString(wideVector, string(35, ZERO) + "1z" + string(62, ZERO) + "x"));
+    EXPECT_TRUE(compareVectorToString(copyVector, string(100, ZERO)));
+    EXPECT_TRUE(wideVector.isUnknown());
+    wideVector.setBit(0, ONE);
+    EXPECT_TRUE(wideVector.isUnknown());
+    wideVector.setBit(63, ZERO);
+    EXPECT_FALSE(wideVector.isUnknown());
+    wideVector.setBit(100, X);
+    wideVector.setBit(-1, X);
+    EXPECT_TRUE(compareVectorToString(wideVector, string(35, ZERO) + "1" + string(63, ZERO) + "1"));
+    EXPECT_FALSE(wideVector.isUnknown());
+    EXPECT_THROW(wideVector.setBit(0, BitValue('2')), vec4stateExceptionInvalidInput);
+}
+
 /// Checks that setting the first bit of a vector that holds 00 to 1 changes the vector to 01. It also checks that the new vector is not equal to the original vector (both logical and case inequality).
 TEST_F(vec4stateTest, TestSetBitSelectZeroesVector) {
     vec4state beforeSet = zeroesVector;
@@ -1034,6 +1462,31 @@ TEST_F(vec4stateTest, TestGetPartSelectFromStringVectorToKnownVector) {
     EXPECT_FALSE(sliceVector.isUnknown());
 }
 
+/// Checks that getPartSelect of a wide vector returns the same bits as the string representation of the vector for slices at every offset within a limb, across limb boundaries, and partially out of range on either side.
+TEST_F(vec4stateTest, TestGetPartSelectWideVectorMatchesString) {
+    const char bitValues[] = {ZERO, ONE, X, Z};
+    string bits;
+    for (int i = 0; i < 200; i++) {
+        bits += bitValues[(i * 7 + i / 5) % 4];
+    }
+    vec4state wideVector(bits);
+    auto expectedSlice = [&](long long end, long long start) {
+        string slice;
+        for (long long i = end; i >= start; i--) {
+            slice += (i < 0 || i >= 200) ? char(X) : bits[size_t(199 - i)];
+        }
+        return slice;
+    };
+    for (long long start = -70; start < 230; start += 13) {
+        for (long long width : {1, 5, 32, 63, 64, 65, 130}) {
+            long long end = start + width - 1;
+            EXPECT_TRUE(compareVectorToString(wideVector.getPartSelect(end, start), expectedSlice(end, start))) << start << " " << end;
+        }
+    }
+    EXPECT_FALSE(vec4state(string(200, ONE)).getPartSelect(150, 10).isUnknown());
+    EXPECT_TRUE(vec4state(string(200, ONE)).getPartSelect(200, 10).isUnknown());
+}
+
 /// Checks that the getPartSelect method throws an exception when the end index is less than the start index.
 TEST_F(vec4stateTest, TestGetPartSelectEndLessThanStart) {
     EXPECT_ANY_THROW(bigVector.getPartSelect(62, 68));
@@ -1124,6 +1577,54 @@ TEST_F(vec4stateTest, TestSetPartSelectBetweenVPIsBigVector) {
     EXPECT_TRUE(checkVectorSize(bigVector, 108));
 }
 
+/// Checks that setPartSelect of a wide vector writes the same bits as splicing the string representations, for slices at every offset within a limb, across limb boundaries, and partially out of range on either side, with values that are shorter and longer than the slice.
+TEST_F(vec4stateTest, TestSetPartSelectWideVectorMatchesString) {
+    const char bitValues[] = {ZERO, ONE, X, Z};
+    string bits;
+    string valueBits;
+    for (int i = 0; i < 200; i++) {
+        bits += bitValues[(i * 7 + i / 5) % 4];
+        valueBits += bitValues[(i * 3 + i / 7 + 1) % 4];
+    }
+    for (long long start = -70; start < 230; start += 13) {
+        for (long long width : {1, 5, 32, 63, 64, 65, 130}) {
+            for (long long valueWidth : {width / 2 + 1, width + 10}) {
+                long long end = start + width - 1;
+                string value = valueBits.substr(0, size_t(valueWidth));
+                vec4state wideVector(bits);
+                wideVector.setPartSelect(end, start, vec4state(value));
+                // Splice the value, zero-extended or truncated to the width of the slice, into the string.
+                string expected = bits;
+                for (long long i = max(start, 0LL); i <= min(end, 199LL); i++) {
+                    long long valueIndex = i - start;
+                    expected[size_t(199 - i)] = (valueIndex < valueWidth) ? value[size_t(valueWidth - 1 - valueIndex)] : char(ZERO);
+                }
+                EXPECT_TRUE(compareVectorToString(wideVector, expected)) << start << " " << end << " " << valueWidth;
+            }
+        }
+    }
+}
+
+/// Checks that setPartSelect keeps the unknown flag of the vector up to date when unknown bits are written, when the only unknown bits are overwritten with known bits, and when a vector is set into itself.
+TEST_F(vec4stateTest, TestSetPartSelectUpdatesUnknown) {
+    vec4state wideVector(string(200, ONE));
+    wideVector.setPartSelect(140, 130, vec4state(string("x")));
+    EXPECT_TRUE(wideVector.isUnknown());
+    wideVector.setPartSelect(129, 120, vec4state(0));
+    EXPECT_TRUE(wideVector.isUnknown());
+    wideVector.setPartSelect(140, 130, vec4state(0));
+    EXPECT_FALSE(wideVector.isUnknown());
+    wideVector.setPartSelect(5, 0, vec4state(string("z")));
+    wideVector.setPartSelect(150, 120, vec4state(0));
+    EXPECT_TRUE(wideVector.isUnknown());
+    vec4state selfVector(string("1x") + string(98, ZERO));
+    selfVector.setPartSelect(199, 0, selfVector);
+    EXPECT_TRUE(compareVectorToString(selfVector, string("1x") + string(98, ZERO)));
+    selfVector.setPartSelect(99, 2, selfVector);
+    EXPECT_TRUE(compareVectorToString(selfVector, string(98, ZERO) + "00"));
+    EXPECT_FALSE(selfVector.isUnknown());
+}
+
 /// Checks that the setPartSelect method throws an exception when the end index is less than the start index.
 TEST_F(vec4stateTest, TestSetPartSelectEndLessThanStart) {
     EXPECT_ANY_THROW(bigVector.setPartSelect(62, 68, string("111")));
@@ -1540,13 +2041,384 @@ TEST_F(vec4stateTest, TestArithmeticSubOnesVectorWithNumber) {
     EXPECT_TRUE(checkVectorSize(subVector, 32));
 }
 
-/*
+/// Checks that a carry and a borrow propagate through every limb of wide vectors, when the operands have the same width and when one of them is shorter, for the operators, the compound assignment operators and the functions in v4.
+TEST_F(vec4stateTest, TestArithmeticCarryAndBorrowChains) {
+    vec4state one(1);
+    for (long long numBits : {64, 65, 200}) {
+        vec4state allOnes(string(numBits, ONE));
+        vec4state topBit("1" + string(numBits - 1, ZERO));
+        EXPECT_TRUE(compareVectorToString(allOnes + one, "1" + string(numBits, ZERO)));
+        EXPECT_TRUE(compareVectorToString(one + allOnes, "1" + string(numBits, ZERO)));
+        EXPECT_TRUE(compareVectorToString(topBit - one, "0" + string(numBits - 1, ONE)));
+        EXPECT_TRUE(compareVectorToString(one - topBit, "1" + string(numBits - 2, ZERO) + "1"));
+        EXPECT_TRUE(compareVectorToString(one - allOnes, string(numBits - 2, ZERO) + "10"));
+        vec4state accumulator = allOnes;
+        accumulator += one;
+        EXPECT_TRUE(compareVectorToString(accumulator, string(numBits, ZERO)));
+        accumulator -= one;
+        EXPECT_TRUE(accumulator.caseEquality(allOnes));
+        vec4state dst = topBit;
+        v4::sub(dst, dst, one);
+        EXPECT_TRUE(compareVectorToString(dst, "0" + string(numBits - 1, ONE)));
+        v4::addWrap(dst, one, dst);
+        EXPECT_TRUE(dst.caseEquality(topBit));
+        v4::add(dst, dst, dst);
+        EXPECT_TRUE(compareVectorToString(dst, "1" + string(numBits, ZERO)));
+    }
+}
+
+/// Checks that the result of the multiplication of a known vector with itself is truncated to the number of bits of the vector.
 TEST_F(vec4stateTest, TestArithmeticMulIntVectorWithItself) {
     vec4state mulVector = intVector * intVector;
     EXPECT_TRUE(compareVectorToString(mulVector, string("00011101111101001101100001000000")));
     EXPECT_TRUE(checkVectorSize(mulVector, 32));
 }
-*/
+
+/// Checks that the products of wide vectors, which are calculated by Karatsuba multiplication, are equal to the sums of the products of one vector by narrow slices of the other vector, which are calculated by Comba multiplication, for full, truncated and unbalanced products.
+TEST_F(vec4stateTest, TestArithmeticMulWideVectors) {
+    unsigned int seed = 1;
+    auto mulBySlices = [](const vec4state& first, const vec4state& second, long long numBits) {
+        vec4state result(string(numBits, ZERO));
+        vec4state partial;
+        for (long long start = 0; start < second.getNumBits(); start += 640) {
+            v4::mulWrap(partial, first, second.getPartSelect(min(start + 639, second.getNumBits() - 1), start), numBits);
+            partial <<= start;
+            v4::addWrap(result, result, partial);
+        }
+        return result;
+    };
+    struct { long long firstNumBits, secondNumBits, numBits; } cases[] = {
+        {4096, 4096, 8192}, {4160, 4160, 8320}, {4096, 4096, 4096}, {8192, 8192, 8192}, {8000, 3000, 11000}, {3000, 8000, 7000}
+    };
+    for (const auto& mulCase : cases) {
+        vec4state first = makePattern(mulCase.firstNumBits, seed);
+        vec4state second = makePattern(mulCase.secondNumBits, seed);
+        vec4state product;
+        v4::mulWrap(product, first, second, mulCase.numBits);
+        EXPECT_TRUE(product.caseEquality(mulBySlices(first, second, mulCase.numBits)));
+    }
+    // (2^n - 1)^2 = 2^2n - 2^(n+1) + 1.
+    vec4state allOnes(string(8192, ONE));
+    vec4state square;
+    v4::mulWrap(square, allOnes, allOnes, 16384);
+    EXPECT_TRUE(compareVectorToString(square, string(8191, ONE) + string(8192, ZERO) + "1"));
+    EXPECT_TRUE(compareVectorToString(allOnes * allOnes, string(8191, ZERO) + "1"));
+}
+
+/// Checks that operator/, operator% and divmod calculate the quotient and the remainder of known vectors of a single limb and of many limbs, where quotient * divisor + remainder is the dividend and the remainder is less than the divisor, and that they handle unknown vectors, division by zero and results that are operands.
+TEST_F(vec4stateTest, TestArithmeticDivmod) {
+    EXPECT_TRUE((vec4state(100) / 7) == 14);
+    EXPECT_TRUE((vec4state(100) % 7) == 2);
+    EXPECT_TRUE(checkVectorSize(vec4state(100) / vec4state(7LL), 64));
+    EXPECT_TRUE((vec4state(0xFEDCBA9876543210ULL) / vec4state(0x123456789ULL)) == (0xFEDCBA9876543210ULL / 0x123456789ULL));
+    EXPECT_TRUE((vec4state(0xFEDCBA9876543210ULL) % vec4state(0x123456789ULL)) == (0xFEDCBA9876543210ULL % 0x123456789ULL));
+    EXPECT_TRUE((vec4state(5) / vec4state(string(100, ONE))) == 0);
+    EXPECT_TRUE((vec4state(5) % vec4state(string(100, ONE))) == 5);
+    unsigned int seed = 7;
+    vec4state quotient, remainder, check;
+    struct { long long dividendNumBits, divisorNumBits; } cases[] = {
+        {32, 32}, {4096, 32}, {4096, 64}, {4096, 100}, {4096, 2000}, {4096, 4000}, {1000, 4096}, {200, 130}
+    };
+    for (const auto& divCase : cases) {
+        vec4state dividend = makePattern(divCase.dividendNumBits, seed);
+        vec4state divisor = makePattern(divCase.divisorNumBits, seed);
+        long long numBits = max(divCase.dividendNumBits, divCase.divisorNumBits);
+        v4::divmod(quotient, remainder, dividend, divisor);
+        EXPECT_TRUE(checkVectorSize(quotient, numBits));
+        EXPECT_TRUE(checkVectorSize(remainder, numBits));
+        EXPECT_TRUE(remainder < divisor);
+        v4::mulWrap(check, quotient, divisor);
+        v4::addWrap(check, check, remainder);
+        EXPECT_TRUE(check.caseEquality(dividend));
+        EXPECT_TRUE((dividend / divisor).caseEquality(quotient));
+        EXPECT_TRUE((dividend % divisor).caseEquality(remainder));
+    }
+    // The results may be the operands.
+    vec4state dividend(1000);
+    vec4state divisor(7);
+    v4::divmod(dividend, divisor, dividend, divisor);
+    EXPECT_TRUE(dividend == 142);
+    EXPECT_TRUE(divisor == 6);
+    v4::divmod(quotient, remainder, vec4state(string("1x")), vec4state(3));
+    EXPECT_TRUE(compareVectorToString(quotient, string(32, X)));
+    EXPECT_TRUE(compareVectorToString(remainder, string(32, X)));
+    EXPECT_THROW(v4::divmod(quotient, remainder, vec4state(3), vec4state(0)), vec4stateExceptionInvalidOperation);
+    EXPECT_THROW(v4::divmod(quotient, quotient, vec4state(3), vec4state(1)), vec4stateExceptionInvalidOperation);
+}
+
+/// Checks that every compound assignment operator gives the same result as assigning the result of the binary operator to the left vector, for vectors of equal and different sizes across limbs.
+TEST_F(vec4stateTest, TestCompoundAssignmentMatchesBinaryOperators) {
+    vector<string> bitStrings = makeOperandBitStrings();
+    for (const string& first : bitStrings) {
+        for (const string& second : bitStrings) {
+            vec4state firstVector(first);
+            vec4state secondVector(second);
+            vec4state result = firstVector;
+            vec4state expected = firstVector;
+            result &= secondVector;
+            expected = expected & secondVector;
+            EXPECT_TRUE(result.caseEquality(expected));
+            EXPECT_EQ(result.isUnknown(), expected.isUnknown());
+            result = firstVector;
+            expected = firstVector;
+            result |= secondVector;
+            expected = expected | secondVector;
+            EXPECT_TRUE(result.caseEquality(expected));
+            EXPECT_EQ(result.isUnknown(), expected.isUnknown());
+            result = firstVector;
+            expected = firstVector;
+            result ^= secondVector;
+            expected = expected ^ secondVector;
+            EXPECT_TRUE(result.caseEquality(expected));
+            EXPECT_EQ(result.isUnknown(), expected.isUnknown());
+            result = firstVector;
+            expected = firstVector;
+            result += secondVector;
+            expected = expected + secondVector;
+            EXPECT_TRUE(result.caseEquality(expected));
+            result = firstVector;
+            expected = firstVector;
+            result -= secondVector;
+            expected = expected - secondVector;
+            EXPECT_TRUE(result.caseEquality(expected));
+            EXPECT_TRUE(checkVectorSize(result, first.size()));
+        }
+    }
+}
+
+/// Checks that the compound assignment operators with an integer keep the size of the vector, discarding the carry out of the most significant bit.
+TEST_F(vec4stateTest, TestCompoundAssignmentWithInteger) {
+    vec4state accumulator = vec4state(string(8, ONE));
+    accumulator += 1;
+    EXPECT_TRUE(compareVectorToString(accumulator, string(8, '0')));
+    EXPECT_TRUE(checkVectorSize(accumulator, 8));
+    accumulator -= 1;
+    EXPECT_TRUE(compareVectorToString(accumulator, string(8, '1')));
+    accumulator ^= 0x0F;
+    EXPECT_TRUE(compareVectorToString(accumulator, string("11110000")));
+    accumulator &= 0x3C;
+    EXPECT_TRUE(compareVectorToString(accumulator, string("00110000")));
+    accumulator |= 0x101;
+    EXPECT_TRUE(compareVectorToString(accumulator, string("00110001")));
+    accumulator += stringVector;
+    EXPECT_TRUE(compareVectorToString(accumulator, string(8, 'x')));
+    EXPECT_TRUE(accumulator.isUnknown());
+}
+
+/// Checks that the shift assignment operators shift the vector in place across limbs, and that a shift by an unknown or out of range amount fills the vector with x's or 0's, respectively.
+TEST_F(vec4stateTest, TestShiftAssignmentAcrossLimbs) {
+    string bits = "1xz0" + string(60, ONE) + "01z" + string(73, ZERO) + "1";
+    for (long long num : {1LL, 31LL, 32LL, 63LL, 64LL, 65LL, 100LL, 140LL}) {
+        vec4state leftVector(bits);
+        leftVector <<= num;
+        EXPECT_TRUE(compareVectorToString(leftVector, bits.substr(num) + string(num, '0')));
+        vec4state rightVector(bits);
+        rightVector >>= vec4state(num);
+        EXPECT_TRUE(compareVectorToString(rightVector, string(num, '0') + bits.substr(0, bits.size() - num)));
+    }
+    vec4state shiftedVector(bits);
+    shiftedVector <<= 141;
+    EXPECT_TRUE(compareVectorToString(shiftedVector, string(141, '0')));
+    EXPECT_FALSE(shiftedVector.isUnknown());
+    shiftedVector = vec4state(bits);
+    shiftedVector >>= stringVector;
+    EXPECT_TRUE(compareVectorToString(shiftedVector, string(141, 'x')));
+    shiftedVector = vec4state("z" + string(140, ONE));
+    shiftedVector <<= 1;
+    EXPECT_FALSE(shiftedVector.isUnknown());
+}
+
+/// Checks that a compound assignment changes only the left vector when its planes are shared with a copy, and that a vector can be used as both operands.
+TEST_F(vec4stateTest, TestCompoundAssignmentCopyOnWriteAndAliasing) {
+    string bits = string(100, ONE) + string(100, ZERO);
+    vec4state original(bits);
+    vec4state copyVector = original;
+    copyVector += 1;
+    EXPECT_TRUE(compareVectorToString(copyVector, string(100, '1') + string(99, '0') + "1"));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+    copyVector = original;
+    copyVector <<= 100;
+    EXPECT_TRUE(compareVectorToString(copyVector, string(200, '0')));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+    vec4state selfVector = original;
+    selfVector += selfVector;
+    EXPECT_TRUE(compareVectorToString(selfVector, string(99, '1') + string(101, '0')));
+    selfVector ^= selfVector;
+    EXPECT_TRUE(compareVectorToString(selfVector, string(200, '0')));
+    EXPECT_TRUE(compareVectorToString(original, bits));
+}
+
+/// Checks that the operators give the same result whether this vector, the other vector or both are temporaries, for vectors of equal and different sizes across limbs.
+TEST_F(vec4stateTest, TestRvalueOperatorsMatchLvalueOperators) {
+    vector<string> bitStrings = makeOperandBitStrings();
+    for (const string& first : bitStrings) {
+        for (const string& second : bitStrings) {
+            vec4state firstVector(first);
+            vec4state secondVector(second);
+            vec4state expected = firstVector & secondVector;
+            EXPECT_TRUE((vec4state(first) & secondVector).caseEquality(expected));
+            EXPECT_TRUE((firstVector & vec4state(second)).caseEquality(expected));
+            EXPECT_TRUE((vec4state(first) & vec4state(second)).caseEquality(expected));
+            expected = firstVector | secondVector;
+            EXPECT_TRUE((vec4state(first) | secondVector).caseEquality(expected));
+            EXPECT_TRUE((firstVector | vec4state(second)).caseEquality(expected));
+            EXPECT_TRUE((vec4state(first) | vec4state(second)).caseEquality(expected));
+            expected = firstVector ^ secondVector;
+            EXPECT_TRUE((vec4state(first) ^ secondVector).caseEquality(expected));
+            EXPECT_TRUE((firstVector ^ vec4state(second)).caseEquality(expected));
+            EXPECT_TRUE((vec4state(first) ^ vec4state(second)).caseEquality(expected));
+            vec4state sum = firstVector + secondVector;
+            vec4state rvalueSum = vec4state(first) + secondVector;
+            EXPECT_TRUE(rvalueSum.caseEquality(sum));
+            EXPECT_TRUE(checkVectorSize(rvalueSum, sum.getNumBits()));
+            rvalueSum = firstVector + vec4state(second);
+            EXPECT_TRUE(rvalueSum.caseEquality(sum));
+            vec4state difference = firstVector - secondVector;
+            vec4state rvalueDifference = vec4state(first) - secondVector;
+            EXPECT_TRUE(rvalueDifference.caseEquality(difference));
+            EXPECT_TRUE(checkVectorSize(rvalueDifference, difference.getNumBits()));
+        }
+        vec4state firstVector(first);
+        EXPECT_TRUE((~vec4state(first)).caseEquality(~firstVector));
+        EXPECT_TRUE((vec4state(first) << 67).caseEquality(firstVector << 67));
+        EXPECT_TRUE((vec4state(first) >> vec4state(3)).caseEquality(firstVector >> vec4state(3)));
+    }
+}
+
+/// Checks that a chained expression calculates each operator in the limbs of an expiring operand, so it allocates planes only for the operators whose operands are both named vectors.
+TEST_F(vec4stateTest, TestChainedExpressionsAllocations) {
+    vec4state first(string(100, ONE) + string(100, ZERO));
+    vec4state second(string(50, ZERO) + string(100, ONE) + string(50, X));
+    vec4state third(string(150, Z) + string(50, ONE));
+    vec4state fourth(string(199, ZERO) + "1");
+    long long allocationsBefore = planeAllocationCount;
+    vec4state bitwiseResult = ((first & second) | third) ^ fourth;
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 1);
+    vec4state firstAndSecond = first & second;
+    vec4state orThird = firstAndSecond | third;
+    EXPECT_TRUE(bitwiseResult.caseEquality(orThird ^ fourth));
+    allocationsBefore = planeAllocationCount;
+    vec4state pairResult = (first & second) | (third ^ fourth);
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 2);
+    vec4state thirdXorFourth = third ^ fourth;
+    EXPECT_TRUE(pairResult.caseEquality(firstAndSecond | thirdXorFourth));
+    allocationsBefore = planeAllocationCount;
+    vec4state shiftResult = ~(first | fourth) << 3 >> 1;
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 1);
+    EXPECT_TRUE(compareVectorToString(shiftResult, string(98, '0') + string(99, '1') + "000"));
+    allocationsBefore = planeAllocationCount;
+    vec4state arithmeticResult = ((first + fourth) - fourth) + first;
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 1);
+    EXPECT_TRUE(compareVectorToString(arithmeticResult, "1" + string(99, '1') + string(101, '0')));
+    EXPECT_TRUE(checkVectorSize(arithmeticResult, 201));
+}
+
+/// Checks that the three-address functions write the same results as the corresponding operators, into a new destination, into a reused destination of a different size, and into a destination that is one of the operands.
+TEST_F(vec4stateTest, TestIntoDestinationMatchesOperators) {
+    vector<string> bitStrings = makeOperandBitStrings();
+    vec4state reused(string(300, ONE));
+    for (const string& firstString : bitStrings) {
+        for (const string& secondString : bitStrings) {
+            vec4state first(firstString);
+            vec4state second(secondString);
+            vec4state expected[] = {first & second, first | second, first ^ second, first.xnor(second), first + second, first - second, first * second};
+            void (*functions[])(vec4state&, const vec4state&, const vec4state&) = {v4::band, v4::bor, v4::bxor, v4::bxnor, v4::add, v4::sub, v4::mul};
+            for (int i = 0; i < 7; i++) {
+                vec4state result;
+                functions[i](result, first, second);
+                EXPECT_TRUE(result.caseEquality(expected[i]));
+                EXPECT_EQ(result.getNumBits(), expected[i].getNumBits());
+                functions[i](reused, first, second);
+                EXPECT_TRUE(reused.caseEquality(expected[i]));
+                EXPECT_EQ(reused.getNumBits(), expected[i].getNumBits());
+                vec4state firstAlias = first;
+                functions[i](firstAlias, firstAlias, second);
+                EXPECT_TRUE(firstAlias.caseEquality(expected[i]));
+                EXPECT_EQ(firstAlias.getNumBits(), expected[i].getNumBits());
+                vec4state secondAlias = second;
+                functions[i](secondAlias, first, secondAlias);
+                EXPECT_TRUE(secondAlias.caseEquality(expected[i]));
+                EXPECT_EQ(secondAlias.getNumBits(), expected[i].getNumBits());
+            }
+        }
+        vec4state first(firstString);
+        v4::bnot(reused, first);
+        EXPECT_TRUE(reused.caseEquality(~first));
+        for (long long num : {0LL, 1LL, 5LL, 64LL, 65LL, 129LL, 1000LL, -1LL}) {
+            v4::shl(reused, first, num);
+            EXPECT_TRUE(reused.caseEquality(first << num));
+            v4::shr(reused, first, num);
+            EXPECT_TRUE(reused.caseEquality(first >> num));
+            vec4state alias = first;
+            v4::shl(alias, alias, num);
+            EXPECT_TRUE(alias.caseEquality(first << num));
+        }
+    }
+}
+
+/// Checks that the three-address functions don't allocate memory when the destination has enough capacity for the result, and that they don't change a vector that shares its planes with the destination.
+TEST_F(vec4stateTest, TestIntoDestinationAllocations) {
+    vec4state first(string(100, ONE) + string(100, ZERO));
+    vec4state second(string(50, ZERO) + string(100, ONE) + string(50, X));
+    vec4state third(string(199, ZERO) + "1");
+    vec4state dst(string(300, ZERO));
+    long long allocationsBefore = planeAllocationCount;
+    v4::band(dst, first, second);
+    v4::bor(dst, dst, third);
+    v4::bxor(dst, first, third);
+    v4::bnot(dst, dst);
+    v4::sub(dst, first, third);
+    v4::shl(dst, first, 70);
+    v4::shr(dst, dst, 3);
+    v4::add(dst, first, first);
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 0);
+    EXPECT_TRUE(compareVectorToString(dst, "1" + string(99, '1') + string(101, '0')));
+    EXPECT_TRUE(checkVectorSize(dst, 201));
+    vec4state copy = dst;
+    v4::band(dst, first, second);
+    EXPECT_TRUE(compareVectorToString(copy, "1" + string(99, '1') + string(101, '0')));
+    EXPECT_TRUE(dst.caseEquality(first & second));
+    allocationsBefore = planeAllocationCount;
+    v4::bxnor(dst, second, third);
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 0);
+}
+
+/// Checks that addWrap and mulWrap keep the width of the result at the width of the longer operand or at a given width, discard the bits beyond it, handle a destination that is an operand, and don't allocate when the destination is reused.
+TEST_F(vec4stateTest, TestWrapArithmetic) {
+    vec4state allOnes(string(70, ONE));
+    vec4state one(1);
+    vec4state dst;
+    v4::addWrap(dst, allOnes, one);
+    EXPECT_TRUE(compareVectorToString(dst, string(70, ZERO)));
+    EXPECT_TRUE(checkVectorSize(dst, 70));
+    v4::addWrap(dst, allOnes, allOnes, 8);
+    EXPECT_TRUE(compareVectorToString(dst, "11111110"));
+    v4::addWrap(dst, vec4state(3), vec4state(4), 100);
+    EXPECT_TRUE(compareVectorToString(dst, string(97, ZERO) + "111"));
+    v4::mulWrap(dst, allOnes, allOnes);
+    EXPECT_TRUE(compareVectorToString(dst, string(69, ZERO) + "1"));
+    v4::mulWrap(dst, vec4state(0xFFFF), vec4state(0xFFFF), 40);
+    EXPECT_TRUE(dst.caseEquality(vec4state("00000000" + vec4state(uint32_t(0xFFFE0001)).toString())));
+    v4::mulWrap(dst, vec4state(string("1x")), allOnes, 4);
+    EXPECT_TRUE(compareVectorToString(dst, "xxxx"));
+    // An accumulator keeps its width and its planes.
+    vec4state accumulator(string(200, ONE));
+    vec4state addend(string(200, ONE));
+    long long allocationsBefore = planeAllocationCount;
+    const limb_t* planeBefore = accumulator.getAvalPlane();
+    for (int i = 0; i < 3; i++) {
+        v4::addWrap(accumulator, accumulator, addend);
+    }
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 0);
+    EXPECT_EQ(accumulator.getAvalPlane(), planeBefore);
+    EXPECT_TRUE(compareVectorToString(accumulator, string(198, ONE) + "00"));
+    v4::addWrap(accumulator, accumulator, one, 10);
+    EXPECT_TRUE(compareVectorToString(accumulator, "1111111101"));
+    v4::mulWrap(accumulator, accumulator, accumulator, 4);
+    EXPECT_TRUE(compareVectorToString(accumulator, "1001"));
+    EXPECT_THROW(v4::addWrap(dst, one, one, 0), vec4stateExceptionInvalidSize);
+    EXPECT_THROW(v4::mulWrap(dst, one, one, -1), vec4stateExceptionInvalidSize);
+}
 
 /// Checks that the conversion of a 4-state vector that holds only known bits to 2-state returns the same vector.
 /// Also checks equality.
@@ -1667,3 +2539,141 @@ TEST_F(vec4stateTest, TestConversionToBoolOneAndXVector) {
 TEST_F(vec4stateTest, TestConversionToBoolStringVector) {
     EXPECT_TRUE(stringVector);
 }
+
+/// Checks that a fixed-width vector is initialized from an integer, a string and a dynamic vector, and that it is truncated or zero-extended to its width.
+TEST_F(vec4stateTest, TestFixedConstructors) {
+    EXPECT_EQ(vec4state_fixed<8>().toString(), "xxxxxxxx");
+    EXPECT_EQ(vec4state_fixed<8>(0x1A5).toString(), "10100101");
+    EXPECT_EQ(vec4state_fixed<40>(-1).toString(), "0000000011111111111111111111111111111111");
+    EXPECT_EQ(vec4state_fixed<6>(string("1xz0")).toString(), "001xz0");
+    EXPECT_THROW(vec4state_fixed<4>(string("102")), vec4stateExceptionInvalidInput);
+    EXPECT_EQ(vec4state_fixed<70>(stringVector).toString(), string(64, '0') + stringVector.toString());
+    EXPECT_EQ(vec4state_fixed<3>(stringVector).toString(), "z11");
+}
+
+/// Checks that a fixed-width vector is converted to a dynamic vector with the same bits.
+TEST_F(vec4stateTest, TestFixedConversionToVec4state) {
+    vec4state converted = vec4state_fixed<100>(stringVector);
+    EXPECT_EQ(converted.getNumBits(), 100);
+    EXPECT_EQ(converted.toString(), string(94, '0') + stringVector.toString());
+    EXPECT_TRUE(converted.isUnknown());
+    vec4state known = vec4state_fixed<16>(0xBEEF);
+    EXPECT_FALSE(known.isUnknown());
+    EXPECT_EQ(known.toString(), vec4state(0xBEEF).getPartSelect(15, 0).toString());
+}
+
+/// Checks that the bitwise operators of fixed-width vectors match the bitwise operators of vec4state.
+TEST_F(vec4stateTest, TestFixedBitwiseOperators) {
+    vec4state_fixed<80> first(string("01xz01xz01xz01xz"));
+    vec4state_fixed<80> second(string("0000111xxxxzzzz1"));
+    vec4state dynamicFirst = first;
+    vec4state dynamicSecond = second;
+    EXPECT_EQ((first & second).toString(), (dynamicFirst & dynamicSecond).toString());
+    EXPECT_EQ((first | second).toString(), (dynamicFirst | dynamicSecond).toString());
+    EXPECT_EQ((first ^ second).toString(), (dynamicFirst ^ dynamicSecond).toString());
+    EXPECT_EQ((~first).toString(), (~dynamicFirst).toString());
+    EXPECT_EQ((vec4state_fixed<4>(string("1x01")) & vec4state_fixed<8>(string("11111111"))).toString(), "00001x01");
+}
+
+/// Checks that the equality, relational and logical operators of fixed-width vectors return 1-bit results.
+TEST_F(vec4stateTest, TestFixedComparisonOperators) {
+    vec4state_fixed<70> small(5);
+    vec4state_fixed<70> big = vec4state_fixed<70>(1) << 68;
+    vec4state_fixed<70> unknown(string("1x"));
+    EXPECT_EQ((small == small).toString(), "1");
+    EXPECT_EQ((small == big).toString(), "0");
+    EXPECT_EQ((small != unknown).toString(), "1");
+    EXPECT_EQ((vec4state_fixed<70>(2) == unknown).toString(), "x");
+    EXPECT_EQ(unknown.caseEquality(unknown).toString(), "1");
+    EXPECT_EQ((small < big).toString(), "1");
+    EXPECT_EQ((small >= big).toString(), "0");
+    EXPECT_EQ((small > unknown).toString(), "x");
+    EXPECT_EQ((small && unknown).toString(), "1");
+    EXPECT_EQ((vec4state_fixed<70>(0) || unknown).toString(), "1");
+    EXPECT_EQ((!vec4state_fixed<70>(string("0x"))).toString(), "x");
+}
+
+/// Checks that the shift operators of fixed-width vectors shift across word boundaries and keep the width of the vector.
+TEST_F(vec4stateTest, TestFixedShiftOperators) {
+    vec4state_fixed<100> vector(string("1xz1"));
+    EXPECT_EQ((vector << 62).toString(), string(34, '0') + "1xz1" + string(62, '0'));
+    EXPECT_EQ(((vector << 97) >> 1).toString(), "0xz1" + string(96, '0'));
+    EXPECT_EQ((vector << 100).toString(), string(100, '0'));
+    EXPECT_EQ((vector >> vec4state_fixed<8>(2)).toString(), string(98, '0') + "1x");
+    EXPECT_EQ((vector << vec4state_fixed<8>(string("x"))).toString(), string(100, 'x'));
+}
+
+/// Checks that the arithmetic operators of fixed-width vectors wrap around their width.
+TEST_F(vec4stateTest, TestFixedArithmeticOperators) {
+    EXPECT_EQ((vec4state_fixed<8>(200) + vec4state_fixed<8>(100)).toString(), vec4state_fixed<8>(44).toString());
+    EXPECT_EQ((vec4state_fixed<8>(1) - vec4state_fixed<8>(2)).toString(), "11111111");
+    EXPECT_EQ((-vec4state_fixed<8>(1)).toString(), "11111111");
+    EXPECT_EQ((vec4state_fixed<16>(300) * vec4state_fixed<16>(300)).toString(), vec4state_fixed<16>(90000 & 0xFFFF).toString());
+    EXPECT_EQ((vec4state_fixed<16>(1000) / vec4state_fixed<16>(7)).toString(), vec4state_fixed<16>(142).toString());
+    EXPECT_EQ((vec4state_fixed<16>(1000) % vec4state_fixed<16>(7)).toString(), vec4state_fixed<16>(6).toString());
+    EXPECT_EQ((vec4state_fixed<16>(1) + vec4state_fixed<16>(string("x"))).toString(), string(16, 'x'));
+    EXPECT_THROW(vec4state_fixed<16>(1) / vec4state_fixed<16>(0), vec4stateExceptionInvalidOperation);
+}
+
+/// Checks that the arithmetic operators of multi-word fixed-width vectors carry between the words.
+TEST_F(vec4stateTest, TestFixedArithmeticMultiWord) {
+    vec4state_fixed<130> maxWord(0xFFFFFFFFFFFFFFFFULL);
+    vec4state_fixed<130> sum = maxWord + vec4state_fixed<130>(1);
+    EXPECT_EQ(sum.toString(), (vec4state_fixed<130>(1) << 64).toString());
+    EXPECT_EQ((sum - vec4state_fixed<130>(1)).toString(), maxWord.toString());
+    vec4state_fixed<130> square = maxWord * maxWord;
+    EXPECT_EQ(square.toString(), ((vec4state_fixed<130>(0xFFFFFFFFFFFFFFFEULL) << 64) + vec4state_fixed<130>(1)).toString());
+    EXPECT_EQ((square / maxWord).toString(), maxWord.toString());
+    EXPECT_EQ((square % maxWord).toString(), vec4state_fixed<130>(0).toString());
+    EXPECT_EQ((vec4state_fixed<130>(0) - vec4state_fixed<130>(1)).toString(), string(130, '1'));
+}
+
+/// Checks that the bit select and part select operators of fixed-width vectors get and set bits across word boundaries.
+TEST_F(vec4stateTest, TestFixedSelectOperators) {
+    vec4state_fixed<100> vector(string("1xz0"));
+    vector = vector << 62;
+    EXPECT_EQ(vector.getBitSelect(65).toString(), "1");
+    EXPECT_EQ(vector.getBitSelect(100).toString(), "x");
+    EXPECT_EQ((vector.getPartSelect<66, 61>()).toString(), "01xz00");
+    EXPECT_EQ((vector.getPartSelect<101, 98>()).toString(), "xx00");
+    vector.setPartSelect<101, 60>(vec4state_fixed<42>(string(42, 'z')));
+    EXPECT_EQ(vector.toString(), string(40, 'z') + string(60, '0'));
+    vector.setBitSelect(0, vec4state_fixed<1>(1));
+    EXPECT_EQ(vector.getBitSelect(0).toString(), "1");
+}
+
+/// Checks that a lazy bitwise expression gives the same result as the eager operators, for vectors of different sizes across limbs and with unknown bits.
+TEST_F(vec4stateTest, TestLazyBitwiseExpressions) {
+    vec4state first(string(100, ONE) + string(30, X) + "01zx");
+    vec4state second(string(60, Z) + "10");
+    vec4state third(string(200, ONE));
+    vec4state result = ((lazy(first) & second) | ~lazy(third)) ^ first;
+    vec4state expected = ((first & second) | ~third) ^ first;
+    EXPECT_TRUE(result.caseEquality(expected));
+    EXPECT_TRUE(checkVectorSize(result, 200));
+    EXPECT_EQ(result.isUnknown(), expected.isUnknown());
+    result = ~lazy(second) & third;
+    expected = ~second & third;
+    EXPECT_TRUE(result.caseEquality(expected));
+    EXPECT_TRUE(compareVectorToString(result, string(138, '0') + string(60, 'x') + "01"));
+    result = second | (lazy(first) ^ stringVector);
+    expected = second | (first ^ stringVector);
+    EXPECT_TRUE(result.caseEquality(expected));
+    vec4state knownResult = lazy(third) & ~lazy(third);
+    EXPECT_TRUE(compareVectorToString(knownResult, string(200, '0')));
+    EXPECT_FALSE(knownResult.isUnknown());
+}
+
+/// Checks that a lazy bitwise expression allocates only the planes of its result.
+TEST_F(vec4stateTest, TestLazyBitwiseExpressionAllocations) {
+    vec4state first(string(100, ONE) + string(100, ZERO));
+    vec4state second(string(50, ZERO) + string(100, ONE) + string(50, X));
+    vec4state third(string(150, Z) + string(50, ONE));
+    long long allocationsBefore = planeAllocationCount;
+    vec4state result = ~((lazy(first) & second) | third) ^ (lazy(second) | first);
+    EXPECT_EQ(planeAllocationCount - allocationsBefore, 1);
+    vec4state firstAndSecond = first & second;
+    vec4state orThird = firstAndSecond | third;
+    vec4state secondOrFirst = second | first;
+    EXPECT_TRUE(result.caseEquality(~orThird ^ secondOrFirst));
+}
@@ -9,839 +9,2369 @@
  */
 
 #include "vec4state.h"
+#include <cstring>
+#include <vector>
+#if !defined(VEC4STATE_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#elif !defined(VEC4STATE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#endif
 
 /**
- * @brief The number of bits in a VPI.
+ * @brief The maximum number of limbs in a vector that can hold a number.
  */
-#define BITS_IN_VPI 32
+#define LIMBS_IN_INDEX_VECTOR (64 / BITS_IN_LIMB)
 
+#if VEC4STATE_LIMB_BITS == 64
 /**
- * @brief The maximum number of VPI elements in a vector that can hold a number.
+ * @brief The number of decimal digits in the largest power of 10 that fits in a limb.
  */
-#define CELLS_IN_INDEX_VECTOR 2
+#define DECIMAL_DIGITS_IN_CHUNK 19
+/**
+ * @brief The largest power of 10 that fits in a limb, which the decimal conversion divides by.
+ */
+#define DECIMAL_CHUNK limb_t(10000000000000000000ULL)
+#else
+#define DECIMAL_DIGITS_IN_CHUNK 9
+#define DECIMAL_CHUNK limb_t(1000000000)
+#endif
+
+/**
+ * @brief The value of an x digit in a literal (above the value of every hexadecimal digit).
+ */
+#define LITERAL_DIGIT_X 16
+
+/**
+ * @brief The value of a z digit in a literal.
+ */
+#define LITERAL_DIGIT_Z 17
+
+/**
+ * @brief The minimal number of bits in an unsized literal.
+ */
+#define LITERAL_UNSIZED_BITS 32
+
+/**
+ * @brief The maximal size of a sized literal, which is the maximal number of bits in a SystemVerilog vector.
+ */
+#define LITERAL_MAX_SIZE (1 << 24)
+
+/**
+ * @brief The number of limbs up to which the decimal conversion divides by DECIMAL_CHUNK limb by limb instead of splitting the number.
+ */
+#define DECIMAL_BASECASE_LIMBS 8
+
+/**
+ * @brief The number of limbs from which the full product of two numbers of the same size is calculated by Karatsuba multiplication instead of Comba multiplication.
+ */
+#define KARATSUBA_THRESHOLD_LIMBS 32
 
 /**
- * @brief A mask for all the bits in a VPI.
+ * @brief The number of limbs from which the low limbs of a product are calculated by splitting the product into a full product of the low halves and two truncated cross products, instead of Comba multiplication of the low limbs only.
  */
-#define MASK_32 0xFFFFFFFF
+#define KARATSUBA_LOW_THRESHOLD_LIMBS 64
 
 /**
- * @brief A mask for the 33rd bit in a VPI.
+ * @brief The number of characters that the string parser classifies at a time: 32 with AVX2, 16 with SSE2, or 0 if the scalar parser is used (e.g. if VEC4STATE_NO_SIMD is defined).
  */
-#define MASK_BIT_33 0x100000000 
+#if !defined(VEC4STATE_NO_SIMD) && defined(__AVX2__)
+#define SIMD_PARSE_WIDTH 32
+#elif !defined(VEC4STATE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define SIMD_PARSE_WIDTH 16
+#else
+#define SIMD_PARSE_WIDTH 0
+#endif
 
 using namespace std;
 
 /**
- * @brief Helper function to calculate the size of the vector.
+ * @brief Helper function to calculate the number of limbs in the vector.
  * 
- * The function calculates the number of VPI elements required in order to hold numBits bits by dividing numBits by the number of bits in a VPI element (32 bits).
+ * The function calculates the number of limbs required in order to hold numBits bits by dividing numBits by the number of bits in a limb (BITS_IN_LIMB).
  * 
  * @param numBits Number of bits in the vector.
- * @return long long The size of the vector.
+ * @return long long The number of limbs in each plane of the vector.
  */
-long long calcVectorSize(long long numBits) {
-    return (numBits + BITS_IN_VPI - 1) / BITS_IN_VPI;
+long long calcNumLimbs(long long numBits) {
+    return (numBits + BITS_IN_LIMB - 1) / BITS_IN_LIMB;
 }
 
 /**
- * @brief Sets unknown field for vec4state.
+ * @brief Helper function to calculate the size of a plane on the heap.
  * 
- * Scans the vector and sets the unknown flag to true if encountered unknown values in the vector, and to false otherwise.
+ * The function rounds numLimbs up to a whole number of PLANE_ALIGNMENT byte blocks, so that the bval plane that follows the aval plane in the same block is aligned as well.
+ * 
+ * @param numLimbs The number of limbs in the vector.
+ * @return long long The number of limbs to reserve for each plane.
  */
-void vec4state::setUnknown() {
-    for (int i = 0; i < vectorSize; i++) {
-        if (vector[i].getBval() != 0) {
-            unknown = true;
-            return;
-        }
-    }
-    unknown = false;
+long long calcPlaneSize(long long numLimbs) {
+    long long limbsInBlock = PLANE_ALIGNMENT / sizeof(limb_t);
+    return (numLimbs + limbsInBlock - 1) / limbsInBlock * limbsInBlock;
 }
 
 /**
- * @brief Increment number of bits for vec4state.
+ * @brief Helper function for zeroing down the bits that are out of range.
  * 
- * Increments the number of bits in the vector to newNumBits by assigning a bigger VPI array to this vector, copying the values from the original array to the new one, and zero-extending the new VPIs in the new array. Throws vec4stateExceptionInvalidSize if newNumBits is less than the current number of bits or non-positive. If newNumBits is the same as the current number of bits, the vector remains unchanged.
+ * Zeroes down the bits that are out of range while vector stays the same size. The function truncates the last relevant limb of both planes and zeroes down the limbs after it up to numLimbs.
  * 
- * @param newNumBits The new number of bits in the vector.
+ * @param aval The aval plane of the vector to zero down the bits in.
+ * @param bval The bval plane of the vector to zero down the bits in.
+ * @param numLimbs The number of limbs in each plane.
+ * @param numBits The number of bits in the vector that are in range.
  */
-void vec4state::incNumBits(long long newNumBits) {
-    if (newNumBits <= 0) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be positive");
-    }
-    if (newNumBits < numBits) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be greater than the current number of bits");
+void zeroDownOutOfRangeBits(limb_t* aval, limb_t* bval, long long numLimbs, long long numBits) {
+    // Find the index of the last relevant limb.
+    long long indexLastCell = calcNumLimbs(numBits) - 1;
+    // Find the offset of the last relevant bit in the last relevant limb.
+    long long offset = numBits % BITS_IN_LIMB;
+    // If the last relevant limb needs to be truncated in the middle.
+    if (offset) {
+        limb_t mask = MASK_LIMB >> (BITS_IN_LIMB - offset);
+        aval[indexLastCell] &= mask;
+        bval[indexLastCell] &= mask;
+    }
+    // Zero down the limbs that are completely out of range.
+    for (long long i = indexLastCell + 1; i < numLimbs; i++) {
+        aval[i] = 0;
+        bval[i] = 0;
     }
-    if (newNumBits == numBits) {
-        return;
-    }
-    long long oldVectorSize = vectorSize;
-    numBits = newNumBits;
-    vectorSize = calcVectorSize(numBits);
-    // If no need to add more VPI elements, leave the array as is.
-    if (vectorSize == oldVectorSize) {
-        return;
-    }
-    shared_ptr<VPI[]> newVector(new VPI[vectorSize], default_delete<VPI[]>());
-    for (long long i = 0; i < vectorSize; i++) {
-        // If the current VPI is still in range of the old array, copy the values from the old array.
-        if (i < oldVectorSize) {
-            newVector[i] = vector[i];
-        }
-        // If the current VPI is out of range of the old array, zero-extend the new VPIs.
-        else {
-            newVector[i].setAval(0);
-            newVector[i].setBval(0);
+}
+
+/**
+ * @brief Shifts limbs to the left.
+ * 
+ * Writes the limbs of the source planes shifted to the left by num bit positions into the destination planes, where the vacated bit positions are filled with zeros. The limbs are moved from the most significant limb down, so the destination planes may be the source planes.
+ * 
+ * @param dstAval The aval plane to write into.
+ * @param dstBval The bval plane to write into.
+ * @param srcAval The aval plane to shift.
+ * @param srcBval The bval plane to shift.
+ * @param numLimbs The number of limbs in the planes.
+ * @param num The number of bit positions to shift by, must be non-negative and less than the number of bits in the planes.
+ */
+void shiftLimbsLeft(limb_t* dstAval, limb_t* dstBval, const limb_t* srcAval, const limb_t* srcBval, long long numLimbs, long long num) {
+    long long offset = num / BITS_IN_LIMB;
+    long long bitShift = num % BITS_IN_LIMB;
+    // Each limb is built from the limb that is offset limbs below it and the bits that are shifted out of the limb below that one. The limbs are read before they are overwritten because the source limbs are never above the destination.
+    for (long long i = numLimbs - 1; i >= offset; i--) {
+        limb_t currAval = srcAval[i - offset] << bitShift;
+        limb_t currBval = srcBval[i - offset] << bitShift;
+        if (bitShift != 0 && i - offset > 0) {
+            currAval |= srcAval[i - offset - 1] >> (BITS_IN_LIMB - bitShift);
+            currBval |= srcBval[i - offset - 1] >> (BITS_IN_LIMB - bitShift);
         }
+        dstAval[i] = currAval;
+        dstBval[i] = currBval;
+    }
+    // The vacated limbs are 0's.
+    for (long long i = offset - 1; i >= 0; i--) {
+        dstAval[i] = 0;
+        dstBval[i] = 0;
     }
-    vector = newVector;
 }
 
 /**
- * @brief Truncate number of bits for vec4state.
+ * @brief Shifts limbs to the right.
  * 
- * Decreases the number of bits in the vector to newNumBits by assigning a smaller VPI array to this vector, copying the values that are in the new range from the original array to the new one, and truncating the VPI that are not in the new range. Throws vec4stateExceptionInvalidSize if newNumBits is greater than the current number of bits or negative. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is 0, the vector is truncated to a single x bit.
+ * Writes the limbs of the source planes shifted to the right by num bit positions into the destination planes, where the vacated bit positions are filled with zeros. The limbs are moved from the least significant limb up, so the destination planes may be the source planes.
  * 
- * @param newNumBits The new number of bits in the vector.
+ * @param dstAval The aval plane to write into.
+ * @param dstBval The bval plane to write into.
+ * @param srcAval The aval plane to shift.
+ * @param srcBval The bval plane to shift.
+ * @param numLimbs The number of limbs in the planes.
+ * @param num The number of bit positions to shift by, must be non-negative and less than the number of bits in the planes.
  */
-void vec4state::decNumBits(long long newNumBits) {
-    if (newNumBits < 0) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be non-negative");
+void shiftLimbsRight(limb_t* dstAval, limb_t* dstBval, const limb_t* srcAval, const limb_t* srcBval, long long numLimbs, long long num) {
+    long long offset = num / BITS_IN_LIMB;
+    long long bitShift = num % BITS_IN_LIMB;
+    // Each limb is built from the limb that is offset limbs above it and the bits that are shifted out of the limb above that one. The limbs are read before they are overwritten because the source limbs are never below the destination.
+    for (long long i = 0; i < numLimbs - offset; i++) {
+        limb_t currAval = srcAval[i + offset] >> bitShift;
+        limb_t currBval = srcBval[i + offset] >> bitShift;
+        if (bitShift != 0 && i + offset + 1 < numLimbs) {
+            currAval |= srcAval[i + offset + 1] << (BITS_IN_LIMB - bitShift);
+            currBval |= srcBval[i + offset + 1] << (BITS_IN_LIMB - bitShift);
+        }
+        dstAval[i] = currAval;
+        dstBval[i] = currBval;
     }
-    if (newNumBits > numBits) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be less than the current number of bits");
+    // The vacated limbs are 0's.
+    for (long long i = numLimbs - offset; i < numLimbs; i++) {
+        dstAval[i] = 0;
+        dstBval[i] = 0;
     }
-    if (newNumBits == numBits) {
-        return;
+}
+
+/**
+ * @brief Reads a limb of bits from any bit index of a plane.
+ * 
+ * Funnel-shifts the limb that holds the bit at bitIndex with the limb above it, so the result holds the BITS_IN_LIMB bits of the plane that start at bitIndex. The bits above the last limb of the plane are read as 0's.
+ * 
+ * @param plane The plane to read from.
+ * @param numLimbs The number of limbs in the plane.
+ * @param bitIndex The index of the first bit to read, must be less than the number of bits in the plane.
+ * @return The bits of the plane from bitIndex, where the bit at bitIndex is the least significant bit.
+ */
+inline limb_t readLimbAtBit(const limb_t* plane, long long numLimbs, long long bitIndex) {
+    long long limbIndex = bitIndex / BITS_IN_LIMB;
+    long long offset = bitIndex % BITS_IN_LIMB;
+    limb_t bits = plane[limbIndex] >> offset;
+    if (offset != 0 && limbIndex + 1 < numLimbs) {
+        bits |= plane[limbIndex + 1] << (BITS_IN_LIMB - offset);
+    }
+    return bits;
+}
+
+/**
+ * @brief Copies a range of bits from one plane into another plane.
+ * 
+ * Writes count bits of the source plane, starting at srcStart, into the destination plane, starting at dstStart, without changing the other bits of the destination. Every destination limb is written once, with the source bits that are read by readLimbAtBit, where only the first and last limbs of the range are merged with their old bits. The cost is proportional to count and not to the sizes of the planes. The planes must not overlap.
+ * 
+ * @param dst The plane to write into.
+ * @param dstStart The index of the first bit to write in dst.
+ * @param src The plane to read from.
+ * @param srcNumLimbs The number of limbs in src.
+ * @param srcStart The index of the first bit to read in src.
+ * @param count The number of bits to copy, where all of them must be in range of both planes.
+ */
+void copyBits(limb_t* dst, long long dstStart, const limb_t* src, long long srcNumLimbs, long long srcStart, long long count) {
+    long long copied = 0;
+    while (copied < count) {
+        long long dstLimbIndex = (dstStart + copied) / BITS_IN_LIMB;
+        long long offset = (dstStart + copied) % BITS_IN_LIMB;
+        long long numBitsInLimb = min<long long>(BITS_IN_LIMB - offset, count - copied);
+        limb_t mask = ((numBitsInLimb == BITS_IN_LIMB) ? MASK_LIMB : ((limb_t(1) << numBitsInLimb) - 1)) << offset;
+        limb_t bits = readLimbAtBit(src, srcNumLimbs, srcStart + copied) << offset;
+        dst[dstLimbIndex] = (mask == MASK_LIMB) ? bits : ((dst[dstLimbIndex] & ~mask) | (bits & mask));
+        copied += numBitsInLimb;
     }
-    if (newNumBits == 0) {
-        *this = vec4state(X, 1);
-        return;
+}
+
+/**
+ * @brief Zeroes down a range of bits in a plane.
+ * 
+ * Clears count bits of the plane, starting at start, without changing the other bits of the plane. Only the first and last limbs of the range are read, and the limbs between them are written whole.
+ * 
+ * @param plane The plane to write into.
+ * @param start The index of the first bit to clear.
+ * @param count The number of bits to clear, where all of them must be in range of the plane.
+ */
+void clearBits(limb_t* plane, long long start, long long count) {
+    long long cleared = 0;
+    while (cleared < count) {
+        long long limbIndex = (start + cleared) / BITS_IN_LIMB;
+        long long offset = (start + cleared) % BITS_IN_LIMB;
+        long long numBitsInLimb = min<long long>(BITS_IN_LIMB - offset, count - cleared);
+        limb_t mask = ((numBitsInLimb == BITS_IN_LIMB) ? MASK_LIMB : ((limb_t(1) << numBitsInLimb) - 1)) << offset;
+        plane[limbIndex] &= ~mask;
+        cleared += numBitsInLimb;
     }
-    long long indexLastCell = calcVectorSize(newNumBits) - 1;
-    long long offset = newNumBits % BITS_IN_VPI;
-    long long mask = MASK_32 >> (BITS_IN_VPI - offset);
-    numBits = newNumBits;
-    // If no need to delete VPI elements, remove the unnecessary bits from the last VPI.
-    if (vectorSize == indexLastCell + 1) {
-        if (offset != 0) {
-            vector[indexLastCell].setAval(vector[indexLastCell].getAval() & mask);
-            vector[indexLastCell].setBval(vector[indexLastCell].getBval() & mask);
+}
+
+/**
+ * @brief Checks if any bit in a range of a plane is set.
+ * 
+ * @param plane The plane to check.
+ * @param numLimbs The number of limbs in the plane.
+ * @param start The index of the first bit to check.
+ * @param count The number of bits to check, where all of them must be in range of the plane.
+ * @return True if at least one of the bits is 1, false otherwise.
+ */
+bool hasSetBits(const limb_t* plane, long long numLimbs, long long start, long long count) {
+    for (long long checked = 0; checked < count; checked += BITS_IN_LIMB) {
+        limb_t bits = readLimbAtBit(plane, numLimbs, start + checked);
+        if (count - checked < BITS_IN_LIMB) {
+            bits &= (limb_t(1) << (count - checked)) - 1;
         }
-        // If the new last cell still holds unknown bits, the vector holds unknown bits. Otherwise, if the vector was unknown before, check the rest of the vector.
-        if (vector[indexLastCell].getBval() != 0) {
-            unknown = true;
-        } else if (unknown) {
-            setUnknown();
+        if (bits != 0) {
+            return true;
         }
     }
-    // If need to remove VPI elements, create a new array with the new size and copy the values that are still in range from the old array.
-    else {
-        vectorSize = indexLastCell + 1;
-        shared_ptr<VPI[]> newVector(new VPI[vectorSize], default_delete<VPI[]>());
-        for (long long i = 0; i <= indexLastCell; i++) {
-            VPI currVPI = vector[i];
-            // If the current cell is still in range, copy the values from the old array.
-            if (i < indexLastCell) {
-                newVector[i] = currVPI;
-                // If the current cell holds unknown bits, the new vector holds unknown bits.
-                if (currVPI.getBval() != 0) {
-                    unknown = true;
-                }
-            }
-            // If the last cell needs to be truncated in the middle, extract the relevant bits.
-            else if (offset != 0) {
-                newVector[i].setAval(currVPI.getAval() & mask);
-                newVector[i].setBval(currVPI.getBval() & mask);
-                // If the new last cell holds unknown bits, the vector holds unknown bits.
-                if (vector[indexLastCell].getBval() != 0) {
-                    unknown = true;
-                }
-            }
+    return false;
+}
+
+/**
+ * @brief Adds two numbers that are stored in limbs.
+ * 
+ * Calculates the sum of first and second into the numLimbs limbs of sumAval (using addWithCarry), where a limb that is out of range of one of the numbers is 0 and the limbs of the sum beyond numLimbs are discarded. The sum holds only known bits, so the limbs of sumBval are zeroed in the same pass. The limbs that both numbers hold are added in a single carry chain, and the rest of the longer number only propagates the carry, so each limb costs a single add-with-carry. Each limb is read before it is overwritten, so sumAval may be first or second. If sumAval is the longer number, the carry propagation stops once the carry is 0, since the rest of the sum already holds the rest of the longer number.
+ * 
+ * @param sumAval The aval limbs to write the sum into.
+ * @param sumBval The bval limbs of the sum.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param firstNumLimbs The number of limbs in first.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param secondNumLimbs The number of limbs in second.
+ * @param numLimbs The number of limbs in the sum.
+ * @return The carry out of the most significant limb of the sum.
+ */
+limb_t addLimbs(limb_t* sumAval, limb_t* sumBval, const limb_t* first, long long firstNumLimbs, const limb_t* second, long long secondNumLimbs, long long numLimbs) {
+    long long sharedLimbs = min(min(firstNumLimbs, secondNumLimbs), numLimbs);
+    const limb_t* longer = (firstNumLimbs >= secondNumLimbs) ? first : second;
+    long long longerNumLimbs = min(max(firstNumLimbs, secondNumLimbs), numLimbs);
+    limb_t carry = 0;
+    long long i = 0;
+    for (; i < sharedLimbs; i++) {
+        sumAval[i] = addWithCarry(first[i], second[i], carry, carry);
+        sumBval[i] = 0;
+    }
+    for (; i < longerNumLimbs; i++) {
+        if (carry == 0 && sumAval == longer) {
+            i = longerNumLimbs;
+            break;
         }
-        vector = newVector;
+        sumAval[i] = addWithCarry(longer[i], 0, carry, carry);
+        sumBval[i] = 0;
     }
+    // Both numbers are 0 beyond the longer number, so only the carry is left.
+    for (; i < numLimbs; i++) {
+        sumAval[i] = carry;
+        sumBval[i] = 0;
+        carry = 0;
+    }
+    return carry;
 }
 
 /**
- * @brief Extract number from vector for vec4state.
- * 
- * Calculates the numerical value that the vector holds by iterating over the vector's VPIs, adding and shifting them. This method can be used only if the vector has up to 2 VPI elements (so it's value can be represented by 64 bits) and has no unknown bits. If the vector has more than 2 VPI elements, vec4stateExceptionInvalidSize is throwns. If the vector has unknown bits, vec4stateExceptionUnknownVector is thrown.
- * 
- * @return The numerical value that the vector holds.
+ * @brief Subtracts two numbers that are stored in limbs.
+ * 
+ * Calculates the difference between first and second into the numLimbs limbs of differenceAval (using subWithBorrow), where a limb that is out of range of one of the numbers is 0 and a negative difference is represented in two's complement of numLimbs limbs. The difference holds only known bits, so the limbs of differenceBval are zeroed in the same pass. The limbs that both numbers hold are subtracted in a single borrow chain, and the rest of the longer number only propagates the borrow, so each limb costs a single subtract-with-borrow. Each limb is read before it is overwritten, so differenceAval may be first or second. If differenceAval is first and first is the longer number, the borrow propagation stops once the borrow is 0.
+ * 
+ * @param differenceAval The aval limbs to write the difference into.
+ * @param differenceBval The bval limbs of the difference.
+ * @param first The limbs of the number to subtract from, from the least significant limb.
+ * @param firstNumLimbs The number of limbs in first.
+ * @param second The limbs of the number to subtract, from the least significant limb.
+ * @param secondNumLimbs The number of limbs in second.
+ * @param numLimbs The number of limbs in the difference.
+ * @return The borrow out of the most significant limb of the difference.
  */
-long long vec4state::extractNumberFromVector() const {
-    // If the vector has 1's after the 64th bit, the value is too large to be represented by 64 bits.
-    for (long long i = vectorSize - 1; i >= CELLS_IN_INDEX_VECTOR; i--) {
-        if (vector[i].getAval() != 0) {
-            throw vec4stateExceptionInvalidSize("Cannot convert a vector that stores more than 64 bits to a number");
+limb_t subLimbs(limb_t* differenceAval, limb_t* differenceBval, const limb_t* first, long long firstNumLimbs, const limb_t* second, long long secondNumLimbs, long long numLimbs) {
+    long long sharedLimbs = min(min(firstNumLimbs, secondNumLimbs), numLimbs);
+    limb_t borrow = 0;
+    long long i = 0;
+    for (; i < sharedLimbs; i++) {
+        differenceAval[i] = subWithBorrow(first[i], second[i], borrow, borrow);
+        differenceBval[i] = 0;
+    }
+    for (long long firstLimbs = min(firstNumLimbs, numLimbs); i < firstLimbs; i++) {
+        if (borrow == 0 && differenceAval == first) {
+            i = firstLimbs;
+            break;
         }
+        differenceAval[i] = subWithBorrow(first[i], 0, borrow, borrow);
+        differenceBval[i] = 0;
     }
-    // If the vector has unknown bits, the value cannot be calculated.
-    if (unknown) {
-        throw vec4stateExceptionUnknownVector("Cannot convert unknown vector to a number");
+    for (long long secondLimbs = min(secondNumLimbs, numLimbs); i < secondLimbs; i++) {
+        differenceAval[i] = subWithBorrow(0, second[i], borrow, borrow);
+        differenceBval[i] = 0;
     }
-    // If the vector holds a value that can be represented by 64 bits, iterate over the VPI elements and calculate the value by adding and shifting the values of the VPI elements.
-    long long result = 0;
-    for (long long i = vectorSize - 1; i >= 0; i--) {
-        result += vector[i].getAval();
-        if (i > 0) {
-            result <<= BITS_IN_VPI;
-        }
+    // Both numbers are 0 beyond the longer number, so only the borrow is left, which is extended as the sign.
+    for (; i < numLimbs; i++) {
+        differenceAval[i] = borrow ? MASK_LIMB : 0;
+        differenceBval[i] = 0;
     }
-    return result;
+    return borrow;
 }
 
 /**
- * @brief Sets the number of bits to a new number for vec4state.
+ * @brief Adds a number to a number that is stored in limbs in place.
  * 
- * Sets the number of bits in the vector to newNumBits by truncating or extending the vector (using decNumBits / incNumBits, respectively). If newNumBits is less than the current number of bits, the vector is truncated. If newNumBits is greater than the current number of bits, the vector is zero-extended. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is negative, vec4stateExceptionInvalidSize is thrown.
+ * Adds addend to the numLimbs limbs of limbs (using addWithCarry), where addendNumLimbs is at most numLimbs, and propagates the carry until it is 0.
  * 
- * @param newNumBits The new number of bits in the vector.
+ * @param limbs The limbs of the number to add to, from the least significant limb.
+ * @param numLimbs The number of limbs in limbs.
+ * @param addend The limbs of the number to add, from the least significant limb.
+ * @param addendNumLimbs The number of limbs in addend.
+ * @return The carry out of the most significant limb of limbs.
  */
-void vec4state::setNumBits(long long newNumBits) {
-    if (newNumBits < 0) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be non-negative");
-    }
-    // If need to extend the vector
-    if (newNumBits > numBits) {
-        incNumBits(newNumBits);
+limb_t addLimbsInPlace(limb_t* limbs, long long numLimbs, const limb_t* addend, long long addendNumLimbs) {
+    limb_t carry = 0;
+    long long i = 0;
+    for (; i < addendNumLimbs; i++) {
+        limbs[i] = addWithCarry(limbs[i], addend[i], carry, carry);
     }
-    // If need to truncate the vector
-    if (newNumBits < numBits) {
-        decNumBits(newNumBits);
+    for (; i < numLimbs && carry != 0; i++) {
+        limbs[i] = addWithCarry(limbs[i], 0, carry, carry);
     }
+    return carry;
 }
 
 /**
- * @brief Default constructor for vec4state.
+ * @brief Subtracts a number from a number that is stored in limbs in place.
  * 
- * Initializes a 1-bit vector, initialized to x.
+ * Subtracts subtrahend from the numLimbs limbs of limbs (using subWithBorrow), where subtrahendNumLimbs is at most numLimbs, and propagates the borrow until it is 0.
+ * 
+ * @param limbs The limbs of the number to subtract from, from the least significant limb.
+ * @param numLimbs The number of limbs in limbs.
+ * @param subtrahend The limbs of the number to subtract, from the least significant limb.
+ * @param subtrahendNumLimbs The number of limbs in subtrahend.
+ * @return The borrow out of the most significant limb of limbs.
  */
-vec4state::vec4state() : vector(nullptr) {
-    vector = shared_ptr<VPI[]>(new VPI[1], default_delete<VPI[]>());
-    numBits = 1;
-    vectorSize = 1;
-    vector[0].setAval(0);
-    vector[0].setBval(1);
-    unknown = true;
+limb_t subLimbsInPlace(limb_t* limbs, long long numLimbs, const limb_t* subtrahend, long long subtrahendNumLimbs) {
+    limb_t borrow = 0;
+    long long i = 0;
+    for (; i < subtrahendNumLimbs; i++) {
+        limbs[i] = subWithBorrow(limbs[i], subtrahend[i], borrow, borrow);
+    }
+    for (; i < numLimbs && borrow != 0; i++) {
+        limbs[i] = subWithBorrow(limbs[i], 0, borrow, borrow);
+    }
+    return borrow;
 }
 
 /**
- * @brief Helper function for filling the vector with bits from a string.
+ * @brief Multiplies two numbers that are stored in limbs by Comba multiplication.
  * 
- * The function iterates over the string's characters (starting from index startStrIndex), translates the BitValues to aval and bval of a VPI, and fills the VPI of vector at index VPIIndex with these BitValues. The filling stops when cellSize bits are filled. If str contains invalid characters, vec4stateExceptionInvalidInput is thrown.
+ * Calculates the low numLimbs limbs of the product of first and second column by column: all the partial products of a limb of the product (using mulWide) are summed into an accumulator of three limbs, and the limb is written once. Only the columns of the low numLimbs limbs are calculated, so a truncated product costs about half of a full product. product must not overlap the factors.
  * 
- * @param vector The vector to fill.
- * @param str The string to read the bits from.
- * @param cellSize The number of bits to fill in the VPI.
- * @param VPIIndex The index of the VPI in the vector to fill.
- * @param startStrIndex The index of the first bit in the string to start reading from.
- * @return The index of the next bit in the string.
+ * @param product The limbs to write the product into.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param firstNumLimbs The number of limbs in first.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param secondNumLimbs The number of limbs in second.
+ * @param numLimbs The number of limbs in product.
  */
-long long fillVPIWithStringBits(shared_ptr<VPI[]> vector, const string& str, long long cellSize, long long VPIIndex, long long startStrIndex) {
-    uint32_t aval = 0;
-    uint32_t bval = 0;
-    // Iterate over the string's characters and fill the VPI with the bits until reaching cellSize.
-    long long currStrIndex = startStrIndex;
-    for (long long currBitIndex = 0; currBitIndex < cellSize; currBitIndex++) {
-        switch(str[currStrIndex]) {
-            // Translate the BitValues to aval and bval of VPI.
-            case ZERO:
-                break;
-            case ONE:
-                aval += 1;
-                break;
-            case X:
-                bval += 1;
-                break;
-            case Z:
-                aval += 1;
-                bval += 1;
-                break;
-            default:
-                throw vec4stateExceptionInvalidInput("Invalid bit: " + str[currStrIndex]);
-        }
-        // If the current bit is not the last bit in the cell, shift the current values to the left to keep on adding.
-        if (currBitIndex < cellSize - 1) {
-            aval = aval << 1;
-            bval = bval << 1;
+void multiplyLimbsComba(limb_t* product, const limb_t* first, long long firstNumLimbs, const limb_t* second, long long secondNumLimbs, long long numLimbs) {
+    limb_t accumulatorLow = 0;
+    limb_t accumulatorMiddle = 0;
+    limb_t accumulatorHigh = 0;
+    for (long long column = 0; column < numLimbs; column++) {
+        long long idxFirstEnd = min(column + 1, firstNumLimbs);
+        for (long long idxFirst = max(0LL, column - secondNumLimbs + 1); idxFirst < idxFirstEnd; idxFirst++) {
+            limb_t high;
+            limb_t low = mulWide(first[idxFirst], second[column - idxFirst], high);
+            limb_t carry;
+            accumulatorLow = addWithCarry(accumulatorLow, low, 0, carry);
+            accumulatorMiddle = addWithCarry(accumulatorMiddle, high, carry, carry);
+            accumulatorHigh += carry;
         }
-        currStrIndex++;
+        product[column] = accumulatorLow;
+        accumulatorLow = accumulatorMiddle;
+        accumulatorMiddle = accumulatorHigh;
+        accumulatorHigh = 0;
     }
-    vector[VPIIndex].setAval(aval);
-    vector[VPIIndex].setBval(bval);
-    return currStrIndex;
 }
 
 /**
- * @brief Bit constructor for vec4state.
- * 
- * Initializes a vector that holds bit of size 1. If bit is a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown.
+ * @brief The number of scratch limbs that multiplyEqualLimbs needs.
  * 
- * @param bit The bit to initialize the vector with, must be a BitValue.
+ * @param numLimbs The number of limbs in each factor.
+ * @return The number of scratch limbs.
  */
-vec4state::vec4state(char bit) : vec4state() {
-    fillVPIWithStringBits(vector, string(1, bit), 1, 0, 0);
+long long multiplyEqualScratchNumLimbs(long long numLimbs) {
+    if (numLimbs < KARATSUBA_THRESHOLD_LIMBS) {
+        return 0;
+    }
+    long long sumNumLimbs = numLimbs - numLimbs / 2 + 1;
+    return 4 * sumNumLimbs + multiplyEqualScratchNumLimbs(sumNumLimbs);
 }
 
 /**
- * @brief String constructor for vec4state.
+ * @brief Multiplies two numbers of the same size that are stored in limbs.
  * 
- * Initializes a vector of size str.length() with the values represented by str. The constructor iterates over the string's characters, translates the BitValues to aval and bval of a VPI, and fills the VPI of vector from last VPI to first VPI with these BitValues. If str contains a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown.
+ * Calculates the full product of first and second, which have numLimbs limbs each, into 2 * numLimbs limbs of product. Small numbers are multiplied by Comba multiplication (using multiplyLimbsComba). From KARATSUBA_THRESHOLD_LIMBS limbs, each number is split into a low half a0 and a high half a1, and the product is calculated from three products of halves (Karatsuba multiplication): a0 * b0, a1 * b1 and (a0 + a1) * (b0 + b1), where the middle part of the product is the last product minus the first two. product must not overlap the factors or scratch.
  * 
- * @param str The value to initialize the vector with, must be a string that holds only BitValues.
+ * @param product The limbs to write the product into.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param numLimbs The number of limbs in each number.
+ * @param scratch Temporary limbs, at least multiplyEqualScratchNumLimbs(numLimbs) of them.
  */
-vec4state::vec4state(string str) : vec4state() {
-    // If the string is empty, creates a default vector.
-    if (str.length() == 0) {
+void multiplyEqualLimbs(limb_t* product, const limb_t* first, const limb_t* second, long long numLimbs, limb_t* scratch) {
+    if (numLimbs < KARATSUBA_THRESHOLD_LIMBS) {
+        multiplyLimbsComba(product, first, numLimbs, second, numLimbs, 2 * numLimbs);
         return;
     }
-    numBits = str.length();
-    vectorSize = calcVectorSize(numBits);
-    vector = shared_ptr<VPI[]>(new VPI[vectorSize], default_delete<VPI[]>());
-    // For each VPI element in the vector, fill it with the bits from the string.
-    int numUndividedBits = numBits % BITS_IN_VPI;
-    long long currStrIndex = 0;
-    for (long long currVPIIndex = vectorSize - 1; currVPIIndex >= 0; currVPIIndex--) {
-        // The constructor reads the string's characters from the MSB to the LSB, therefore if the string's length doesn't divide by 32, then the last VPI (where the 32 MSBs are stored) needs alignment to 32 bits (by zero-extension).
-        if (currVPIIndex == vectorSize - 1 && numUndividedBits != 0) {
-            try {
-                currStrIndex = fillVPIWithStringBits(vector, str, numUndividedBits, currVPIIndex, 0);
-            } catch (vec4stateExceptionInvalidInput& e) {
-                throw e;
-            }
-        }
-        // For the rest of the elements in the vector, fill them with the bits from the string as usual.
-        else {
-            try {
-                currStrIndex = fillVPIWithStringBits(vector, str, BITS_IN_VPI, currVPIIndex, currStrIndex);
-            } catch (vec4stateExceptionInvalidInput& e) {
-                throw e;
-            }
-        }
+    long long lowNumLimbs = numLimbs / 2;
+    long long highNumLimbs = numLimbs - lowNumLimbs;
+    // The products of the low halves and of the high halves are the low and high parts of the product.
+    multiplyEqualLimbs(product, first, second, lowNumLimbs, scratch);
+    multiplyEqualLimbs(product + 2 * lowNumLimbs, first + lowNumLimbs, second + lowNumLimbs, highNumLimbs, scratch);
+    // The sums of the halves have one more limb for the carry.
+    long long sumNumLimbs = highNumLimbs + 1;
+    limb_t* firstSum = scratch;
+    limb_t* secondSum = firstSum + sumNumLimbs;
+    limb_t* middle = secondSum + sumNumLimbs;
+    for (long long i = 0; i < highNumLimbs; i++) {
+        firstSum[i] = first[lowNumLimbs + i];
+        secondSum[i] = second[lowNumLimbs + i];
+    }
+    firstSum[highNumLimbs] = addLimbsInPlace(firstSum, highNumLimbs, first, lowNumLimbs);
+    secondSum[highNumLimbs] = addLimbsInPlace(secondSum, highNumLimbs, second, lowNumLimbs);
+    multiplyEqualLimbs(middle, firstSum, secondSum, sumNumLimbs, middle + 2 * sumNumLimbs);
+    // a0 * b1 + a1 * b0 = (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1, which is added to the product at the limb of the high halves. The top limbs of middle are 0, and they are within the product since the low half has at least 2 limbs.
+    subLimbsInPlace(middle, 2 * sumNumLimbs, product, 2 * lowNumLimbs);
+    subLimbsInPlace(middle, 2 * sumNumLimbs, product + 2 * lowNumLimbs, 2 * highNumLimbs);
+    addLimbsInPlace(product + lowNumLimbs, 2 * numLimbs - lowNumLimbs, middle, 2 * sumNumLimbs);
+}
+
+/**
+ * @brief The number of scratch limbs that multiplyLowEqualLimbs needs.
+ * 
+ * @param numLimbs The number of limbs in each factor.
+ * @return The number of scratch limbs.
+ */
+long long multiplyLowEqualScratchNumLimbs(long long numLimbs) {
+    if (numLimbs < KARATSUBA_LOW_THRESHOLD_LIMBS) {
+        return 0;
     }
-    setUnknown();
+    long long lowNumLimbs = numLimbs - numLimbs / 2;
+    long long highNumLimbs = numLimbs / 2;
+    return max(2 * lowNumLimbs + multiplyEqualScratchNumLimbs(lowNumLimbs), highNumLimbs + multiplyLowEqualScratchNumLimbs(highNumLimbs));
 }
 
 /**
- * @brief Single repeated BitValue constructor for vec4state.
+ * @brief Multiplies two numbers of the same size that are stored in limbs, truncated to their size.
  * 
- * Initializes a vector with a single bit (that can be either 0, 1, x, or z) repeated numBits times. If numBits is non-positive or bit is not a BitValue, the vector is default initialized and vec4stateExceptionInvalidSize or vec4stateExceptionInvalidInput is thrown, respectively. 
+ * Calculates the low numLimbs limbs of the product of first and second, which have numLimbs limbs each, into product. Small numbers are multiplied by Comba multiplication of the low limbs only (using multiplyLimbsComba). From KARATSUBA_LOW_THRESHOLD_LIMBS limbs, each number is split into a low half a0 and a high half a1, and the product is the full product a0 * b0 (using multiplyEqualLimbs) plus the truncated cross products a1 * b0 and a0 * b1 (calculated recursively) at the limb of the high halves, where a1 * b1 is out of range. product must not overlap the factors or scratch.
  * 
- * @param bit The bit to repeat.
- * @param numBits The number of bits in the vector.
+ * @param product The limbs to write the product into.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param numLimbs The number of limbs in each number and in product.
+ * @param scratch Temporary limbs, at least multiplyLowEqualScratchNumLimbs(numLimbs) of them.
  */
-vec4state::vec4state(BitValue bit, long long numBits) : vec4state(string(numBits, bit)) {
-    if (bit != ZERO && bit != ONE && bit != X && bit != Z) {
-        throw vec4stateExceptionInvalidInput("Invalid bit");
-    }
-    if (numBits <= 0) {
-        throw vec4stateExceptionInvalidSize("Number of bits must be greater than 0");
+void multiplyLowEqualLimbs(limb_t* product, const limb_t* first, const limb_t* second, long long numLimbs, limb_t* scratch) {
+    if (numLimbs < KARATSUBA_LOW_THRESHOLD_LIMBS) {
+        multiplyLimbsComba(product, first, numLimbs, second, numLimbs, numLimbs);
+        return;
     }
+    long long lowNumLimbs = numLimbs - numLimbs / 2;
+    long long highNumLimbs = numLimbs / 2;
+    // The full product of the low halves might have one limb beyond numLimbs, so it is calculated in scratch.
+    multiplyEqualLimbs(scratch, first, second, lowNumLimbs, scratch + 2 * lowNumLimbs);
+    for (long long i = 0; i < numLimbs; i++) {
+        product[i] = scratch[i];
+    }
+    // The cross products are truncated to the limbs above the low half, so only the low limbs of the factors are needed.
+    multiplyLowEqualLimbs(scratch, first + lowNumLimbs, second, highNumLimbs, scratch + highNumLimbs);
+    addLimbsInPlace(product + lowNumLimbs, highNumLimbs, scratch, highNumLimbs);
+    multiplyLowEqualLimbs(scratch, first, second + lowNumLimbs, highNumLimbs, scratch + highNumLimbs);
+    addLimbsInPlace(product + lowNumLimbs, highNumLimbs, scratch, highNumLimbs);
 }
 
 /**
- * @brief Copy constructor for vec4state.
+ * @brief Multiplies two numbers that are stored in limbs.
  * 
- * Initializes a new vector and copies the values from the other vector to the new vector.
+ * Calculates the full product of first and second, where product must have room for firstNumLimbs + secondNumLimbs limbs and must not overlap the factors. If the shorter number is small, the product is calculated by Comba multiplication (using multiplyLimbsComba). Otherwise, the longer number is split into chunks of the size of the shorter number, and the product of each chunk is calculated by Karatsuba multiplication (using multiplyEqualLimbs) and added to the product.
  * 
- * @param other The vector to copy from.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param firstNumLimbs The number of limbs in first.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param secondNumLimbs The number of limbs in second.
+ * @param product The limbs to write the product into.
  */
-vec4state::vec4state(const vec4state& other) : numBits(other.numBits), vectorSize(other.vectorSize), unknown(other.unknown), vector(nullptr) {
-    vector = shared_ptr<VPI[]>(new VPI[vectorSize], default_delete<VPI[]>());
-    for (int i = 0; i < vectorSize; i++) {
-        vector[i] = other.vector[i];
+void multiplyLimbs(const limb_t* first, long long firstNumLimbs, const limb_t* second, long long secondNumLimbs, limb_t* product) {
+    if (firstNumLimbs < secondNumLimbs) {
+        swap(first, second);
+        swap(firstNumLimbs, secondNumLimbs);
+    }
+    if (secondNumLimbs < KARATSUBA_THRESHOLD_LIMBS) {
+        multiplyLimbsComba(product, first, firstNumLimbs, second, secondNumLimbs, firstNumLimbs + secondNumLimbs);
+        return;
+    }
+    if (firstNumLimbs == secondNumLimbs) {
+        vector<limb_t> scratch(multiplyEqualScratchNumLimbs(secondNumLimbs));
+        multiplyEqualLimbs(product, first, second, secondNumLimbs, scratch.data());
+        return;
+    }
+    // Each chunk of first is zero-extended to the size of second, and its product is added to the product at the limb of the chunk.
+    vector<limb_t> scratch(3 * secondNumLimbs + multiplyEqualScratchNumLimbs(secondNumLimbs));
+    limb_t* chunk = scratch.data();
+    limb_t* chunkProduct = chunk + secondNumLimbs;
+    for (long long i = 0; i < firstNumLimbs + secondNumLimbs; i++) {
+        product[i] = 0;
+    }
+    for (long long offset = 0; offset < firstNumLimbs; offset += secondNumLimbs) {
+        long long chunkNumLimbs = min(secondNumLimbs, firstNumLimbs - offset);
+        for (long long i = 0; i < secondNumLimbs; i++) {
+            chunk[i] = (i < chunkNumLimbs) ? first[offset + i] : 0;
+        }
+        multiplyEqualLimbs(chunkProduct, chunk, second, secondNumLimbs, chunkProduct + 2 * secondNumLimbs);
+        addLimbsInPlace(product + offset, firstNumLimbs + secondNumLimbs - offset, chunkProduct, chunkNumLimbs + secondNumLimbs);
     }
 }
 
 /**
- * @brief Move constructor for vec4state.
+ * @brief Multiplies two numbers that are stored in limbs, truncated to a number of limbs.
  * 
- * Initializes a new vector with the same values as other, and transfers the ownership of the vector to the new object. The other vector is left in a valid but unspecified state.
+ * Calculates the low numLimbs limbs of the product of first and second into product, which must not overlap the factors. Only the low numLimbs limbs and the significant limbs (up to the last limb that isn't 0) of the factors take part. If the full product fits in numLimbs limbs, it is calculated by multiplyLimbs and zero-extended. If both factors fill numLimbs limbs and they are wide, the truncated product is calculated by multiplyLowEqualLimbs. Otherwise, only the low numLimbs columns are calculated by Comba multiplication (using multiplyLimbsComba).
  * 
- * @param other The vector to move from.
+ * @param product The limbs to write the product into.
+ * @param first The limbs of the first number, from the least significant limb.
+ * @param firstNumLimbs The number of limbs in first.
+ * @param second The limbs of the second number, from the least significant limb.
+ * @param secondNumLimbs The number of limbs in second.
+ * @param numLimbs The number of limbs in product.
  */
-vec4state::vec4state(vec4state&& other) noexcept : numBits(other.numBits), vectorSize(other.vectorSize), unknown(other.unknown), vector(other.vector) {
-    other.vector.reset();
+void multiplyLowLimbs(limb_t* product, const limb_t* first, long long firstNumLimbs, const limb_t* second, long long secondNumLimbs, long long numLimbs) {
+    firstNumLimbs = min(firstNumLimbs, numLimbs);
+    secondNumLimbs = min(secondNumLimbs, numLimbs);
+    while (firstNumLimbs > 0 && first[firstNumLimbs - 1] == 0) {
+        firstNumLimbs--;
+    }
+    while (secondNumLimbs > 0 && second[secondNumLimbs - 1] == 0) {
+        secondNumLimbs--;
+    }
+    if (firstNumLimbs == 0 || secondNumLimbs == 0) {
+        for (long long i = 0; i < numLimbs; i++) {
+            product[i] = 0;
+        }
+        return;
+    }
+    if (firstNumLimbs + secondNumLimbs <= numLimbs) {
+        multiplyLimbs(first, firstNumLimbs, second, secondNumLimbs, product);
+        for (long long i = firstNumLimbs + secondNumLimbs; i < numLimbs; i++) {
+            product[i] = 0;
+        }
+        return;
+    }
+    if (firstNumLimbs == numLimbs && secondNumLimbs == numLimbs && numLimbs >= KARATSUBA_LOW_THRESHOLD_LIMBS) {
+        vector<limb_t> scratch(multiplyLowEqualScratchNumLimbs(numLimbs));
+        multiplyLowEqualLimbs(product, first, second, numLimbs, scratch.data());
+        return;
+    }
+    multiplyLimbsComba(product, first, firstNumLimbs, second, secondNumLimbs, numLimbs);
 }
 
 /**
- * @brief Assignment operator for vec4state.
+ * @brief Divides two numbers that are stored in limbs.
  * 
- * Assigns the values of other to this vector. If the other vector is shorter than this vector, zeroes down the bits that are out of range.
+ * Calculates the quotient and the remainder of dividend / divisor with Knuth's algorithm D: the divisor is normalized so that its most significant bit is set, and each limb of the quotient is estimated from the top limbs of the partial remainder (using divWide), corrected by the second limb of the divisor, and then fixed by adding the divisor back in the rare case that the estimate is still 1 too large. A divisor of a single limb is divided limb by limb.
  * 
- * @param other The vector to assign from.
- * @return A reference to this vector.
+ * @param dividend The limbs of the dividend, from the least significant limb.
+ * @param dividendNumLimbs The number of limbs in dividend, must be at least divisorNumLimbs.
+ * @param divisor The limbs of the divisor, from the least significant limb. The most significant limb must not be 0.
+ * @param divisorNumLimbs The number of limbs in divisor.
+ * @param quotient The limbs to write the quotient into, must have room for dividendNumLimbs - divisorNumLimbs + 1 limbs.
+ * @param remainder The limbs to write the remainder into, must have room for divisorNumLimbs limbs.
  */
-vec4state& vec4state::operator=(const vec4state& other) {
-    if (this == &other) {
-        return *this;
-    }
-    // Change the value of unknown because assigning another value.
-    unknown = false;
-    // Setting this vector's bits to the other vector's bits.
-    for (long long i = 0; i < min(this->vectorSize, other.vectorSize); i++) {
-        this->vector[i] = other.vector[i];
-        // If the other's vector has unknown bits, this vector has unknown bits.
-        if (vector[i].getBval() != 0) {
-            unknown = true;
+void divideLimbs(const limb_t* dividend, long long dividendNumLimbs, const limb_t* divisor, long long divisorNumLimbs, limb_t* quotient, limb_t* remainder) {
+    if (divisorNumLimbs == 1) {
+        limb_t currRemainder = 0;
+        for (long long i = dividendNumLimbs - 1; i >= 0; i--) {
+            quotient[i] = divWide(currRemainder, dividend[i], divisor[0], currRemainder);
         }
+        remainder[0] = currRemainder;
+        return;
     }
-    // In case the other vector is shorter than this vector, put 0's in the remaining cells.
-    if (other.vectorSize < vectorSize) {
-        for (long long i = other.vectorSize; i < vectorSize; i++) {
-            vector[i].setAval(0);
-            vector[i].setBval(0);
+    // Normalize the divisor and shift the dividend by the same number of bits, into an extra limb.
+    int shift = countLeadingZeros(divisor[divisorNumLimbs - 1]);
+    unique_ptr<limb_t[]> normalizedDivisor(new limb_t[divisorNumLimbs]);
+    unique_ptr<limb_t[]> partialRemainder(new limb_t[dividendNumLimbs + 1]);
+    for (long long i = divisorNumLimbs - 1; i > 0; i--) {
+        normalizedDivisor[i] = (divisor[i] << shift) | (shift != 0 ? divisor[i - 1] >> (BITS_IN_LIMB - shift) : 0);
+    }
+    normalizedDivisor[0] = divisor[0] << shift;
+    partialRemainder[dividendNumLimbs] = shift != 0 ? dividend[dividendNumLimbs - 1] >> (BITS_IN_LIMB - shift) : 0;
+    for (long long i = dividendNumLimbs - 1; i > 0; i--) {
+        partialRemainder[i] = (dividend[i] << shift) | (shift != 0 ? dividend[i - 1] >> (BITS_IN_LIMB - shift) : 0);
+    }
+    partialRemainder[0] = dividend[0] << shift;
+    limb_t divisorTop = normalizedDivisor[divisorNumLimbs - 1];
+    limb_t divisorSecond = normalizedDivisor[divisorNumLimbs - 2];
+    for (long long j = dividendNumLimbs - divisorNumLimbs; j >= 0; j--) {
+        limb_t* currRemainder = partialRemainder.get() + j;
+        // Estimate the quotient limb from the top two limbs of the partial remainder. The top limb is at most divisorTop, and if it is equal, the estimate is the largest limb.
+        limb_t estimate, estimateRemainder;
+        bool remainderOverflow = false;
+        if (currRemainder[divisorNumLimbs] >= divisorTop) {
+            estimate = MASK_LIMB;
+            estimateRemainder = currRemainder[divisorNumLimbs - 1] + divisorTop;
+            remainderOverflow = estimateRemainder < divisorTop;
+        } else {
+            estimate = divWide(currRemainder[divisorNumLimbs], currRemainder[divisorNumLimbs - 1], divisorTop, estimateRemainder);
+        }
+        // Correct the estimate with the second limb of the divisor, which leaves it at most 1 too large.
+        while (!remainderOverflow) {
+            limb_t productHigh;
+            limb_t productLow = mulWide(estimate, divisorSecond, productHigh);
+            if (productHigh < estimateRemainder || (productHigh == estimateRemainder && productLow <= currRemainder[divisorNumLimbs - 2])) {
+                break;
+            }
+            estimate--;
+            estimateRemainder += divisorTop;
+            remainderOverflow = estimateRemainder < divisorTop;
+        }
+        // Subtract the divisor multiplied by the estimate from the partial remainder.
+        limb_t carry = 0;
+        limb_t borrow = 0;
+        for (long long i = 0; i < divisorNumLimbs; i++) {
+            limb_t high;
+            limb_t low = mulWide(estimate, normalizedDivisor[i], high);
+            limb_t carryLow;
+            low = addWithCarry(low, carry, 0, carryLow);
+            carry = high + carryLow;
+            currRemainder[i] = subWithBorrow(currRemainder[i], low, borrow, borrow);
         }
+        currRemainder[divisorNumLimbs] = subWithBorrow(currRemainder[divisorNumLimbs], carry, borrow, borrow);
+        // If the partial remainder is negative, the estimate was 1 too large, so the divisor is added back.
+        if (borrow) {
+            estimate--;
+            limb_t addCarry = 0;
+            for (long long i = 0; i < divisorNumLimbs; i++) {
+                currRemainder[i] = addWithCarry(currRemainder[i], normalizedDivisor[i], addCarry, addCarry);
+            }
+            currRemainder[divisorNumLimbs] += addCarry;
+        }
+        quotient[j] = estimate;
     }
-    // Zero down the bits that are out of range.
-    if (numBits % BITS_IN_VPI != 0) {
-        vector[vectorSize - 1].setAval(vector[vectorSize - 1].getAval() & (MASK_32 >> (BITS_IN_VPI - (numBits % BITS_IN_VPI))));
-        vector[vectorSize - 1].setBval(vector[vectorSize - 1].getBval() & (MASK_32 >> (BITS_IN_VPI - (numBits % BITS_IN_VPI))));
+    // The remainder is in the lower limbs of the partial remainder, shifted by the normalization.
+    for (long long i = 0; i < divisorNumLimbs; i++) {
+        remainder[i] = (partialRemainder[i] >> shift) | (shift != 0 ? partialRemainder[i + 1] << (BITS_IN_LIMB - shift) : 0);
     }
-    return *this;
 }
 
 /**
- * @brief Bitwise AND operator for vec4state.
+ * @brief Allocates the storage of the aval and bval planes for vec4state.
  * 
- * Calculates the bitwise AND of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise NOT of each vector, then calculates the bitwise OR of the NOT vectors, and finally calculates the bitwise NOT of the result vector.
+ * Sets the number of limbs of the vector to newNumLimbs and points the planes to the inline storage if newNumLimbs is at most INLINE_NUM_LIMBS. Otherwise, allocates a single PLANE_ALIGNMENT aligned block on the heap that holds the aval plane followed by the bval plane. The values of the limbs are not initialized.
  * 
- * @param other The vector to perform the bitwise AND operation with.
- * @return A new vector that holds the result of the bitwise AND operation.
+ * @param newNumLimbs The new number of limbs in each plane.
  */
-vec4state vec4state::operator&(const vec4state& other) const {
-    vec4state result = vec4state(ZERO, max(numBits, other.numBits));
-    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
-    if (numBits < other.numBits) {
-        vec4state copyThis = *this;
-        copyThis.setNumBits(other.numBits);
-        result = ~(~copyThis | ~other);
-    } else if (numBits > other.numBits) {
-        vec4state copyOther = other;
-        copyOther.setNumBits(numBits);
-        result = ~(~(*this) | ~copyOther);
+void vec4state::allocateVector(long long newNumLimbs) {
+    numLimbs = newNumLimbs;
+    // Small vectors are stored inside the object, so no memory is allocated.
+    if (newNumLimbs <= INLINE_NUM_LIMBS) {
+        heapPlanes.reset();
+        aval = inlineAval;
+        bval = inlineBval;
+        capacity = INLINE_NUM_LIMBS;
     } else {
-        result = ~(~(*this) | ~other);
+        long long planeSize = calcPlaneSize(newNumLimbs);
+        limb_t* block = static_cast<limb_t*>(::operator new(2 * planeSize * sizeof(limb_t), align_val_t(PLANE_ALIGNMENT)));
+        heapPlanes = shared_ptr<limb_t>(block, [](limb_t* ptr) {
+            ::operator delete(ptr, align_val_t(PLANE_ALIGNMENT));
+        });
+        aval = block;
+        bval = block + planeSize;
+        capacity = planeSize;
     }
-    return move(result);
 }
 
 /**
- * @brief Bitwise OR operator for vec4state.
+ * @brief Resizes the storage of the aval and bval planes for vec4state.
  * 
- * Calculates the bitwise OR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 1, the result bit is 1.
- * If both bits are 0, the result bit is 0. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector.
+ * Changes the number of limbs in the planes to newNumLimbs, keeping the values of the limbs that are still in range and zero-extending the new limbs. If the planes are owned only by this vector and have enough capacity, the limbs stay in place. Otherwise, the limbs are moved to new storage.
  * 
- * @param other The vector to perform the bitwise OR operation with.
- * @return A new vector that holds the result of the bitwise OR operation.
+ * @param newNumLimbs The new number of limbs in each plane.
+ */
+void vec4state::resizeVector(long long newNumLimbs) {
+    long long oldNumLimbs = numLimbs;
+    // If the planes are not shared and have enough capacity, the limbs stay in place.
+    if (newNumLimbs <= capacity && (!heapPlanes || heapPlanes.use_count() == 1)) {
+        numLimbs = newNumLimbs;
+    } else {
+        // Keep the old limbs alive until they are copied to the new storage.
+        limb_t* oldAval = aval;
+        limb_t* oldBval = bval;
+        shared_ptr<limb_t> oldHeapPlanes = heapPlanes;
+        allocateVector(newNumLimbs);
+        if (aval != oldAval) {
+            for (long long i = 0; i < min(oldNumLimbs, newNumLimbs); i++) {
+                aval[i] = oldAval[i];
+                bval[i] = oldBval[i];
+            }
+        }
+    }
+    // Zero-extend the new limbs.
+    for (long long i = oldNumLimbs; i < newNumLimbs; i++) {
+        aval[i] = 0;
+        bval[i] = 0;
+    }
+}
+
+/**
+ * @brief Reshapes the vector to hold the result of an operation.
+ * 
+ * Sets the number of bits in the vector to newNumBits and makes this vector the only owner of its planes, so that the limbs can be overwritten. The planes are reallocated only if they are shared with another vector or if the vector does not have enough capacity for newNumBits bits. If keepValues is true (when this vector is also an operand of the operation), the vector is zero-extended or truncated to newNumBits in place. Otherwise, the values of the limbs are not initialized.
+ * 
+ * @param newNumBits The new number of bits in the vector.
+ * @param keepValues true to keep the values of the vector.
+ */
+void vec4state::reshape(long long newNumBits, bool keepValues) {
+    if (keepValues) {
+        if (newNumBits >= numBits) {
+            incNumBits(newNumBits);
+            makeUnique();
+            return;
+        }
+        // Truncate the vector without releasing its planes.
+        makeUnique();
+        numLimbs = calcNumLimbs(newNumBits);
+        numBits = newNumBits;
+        zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+        if (unknown) {
+            setUnknown();
+        }
+        return;
+    }
+    long long newNumLimbs = calcNumLimbs(newNumBits);
+    // The values are overwritten, so shared planes are replaced without copying them.
+    if (newNumLimbs > capacity || (heapPlanes && heapPlanes.use_count() > 1)) {
+        allocateVector(newNumLimbs);
+    } else {
+        numLimbs = newNumLimbs;
+    }
+    numBits = newNumBits;
+}
+
+/**
+ * @brief Copies a vector into this vector.
+ * 
+ * Makes this vector hold the same bits as other vector, including its number of bits (unlike the assignment operator, which keeps the number of bits of this vector). The limbs are copied into the planes of this vector, which are reallocated only if needed (see reshape).
+ * 
+ * @param other The vector to copy.
+ */
+void vec4state::copyFrom(const vec4state& other) {
+    if (this == &other) {
+        return;
+    }
+    reshape(other.numBits, false);
+    for (long long i = 0; i < numLimbs; i++) {
+        aval[i] = other.aval[i];
+        bval[i] = other.bval[i];
+    }
+    unknown = other.unknown;
+}
+
+/**
+ * @brief Makes this vector the only owner of its planes.
+ * 
+ * Copies of a vector that is stored on the heap share its planes until one of them is changed. This method must be called before changing the limbs of the planes in place: if the planes are shared with another vector, they are cloned into a new block that only this vector owns. Inline planes are never shared, so they are left as is.
+ */
+void vec4state::makeUnique() {
+    if (!heapPlanes || heapPlanes.use_count() == 1) {
+        return;
+    }
+    // Keep the shared limbs alive until they are copied to the new block.
+    limb_t* oldAval = aval;
+    limb_t* oldBval = bval;
+    shared_ptr<limb_t> oldHeapPlanes = heapPlanes;
+    allocateVector(numLimbs);
+    for (long long i = 0; i < numLimbs; i++) {
+        aval[i] = oldAval[i];
+        bval[i] = oldBval[i];
+    }
+}
+
+/**
+ * @brief Fills the vector with a single bit.
+ * 
+ * Sets every bit of the vector to bit (that can be either 0, 1, x, or z), keeping the number of bits of the vector. The aval and bval planes are set with memset and only the last limb is masked. The limbs are overwritten in place, and if the planes are shared with another vector, a new block is allocated for this vector without copying the shared limbs. If bit is not a BitValue, vec4stateExceptionInvalidInput is thrown and the vector is left unchanged.
+ * 
+ * @param bit The bit to fill the vector with.
+ */
+void vec4state::fill(BitValue bit) {
+    if (bit != ZERO && bit != ONE && bit != X && bit != Z) {
+        throw vec4stateExceptionInvalidInput("Invalid bit");
+    }
+    if (heapPlanes && heapPlanes.use_count() > 1) {
+        allocateVector(numLimbs);
+    }
+    // 1 and z bits are set in aval, x and z bits are set in bval. Every byte of a limb is the same, so the planes are set a byte at a time.
+    bool avalBits = bit == ONE || bit == Z;
+    bool bvalBits = bit == X || bit == Z;
+    memset(aval, avalBits ? 0xFF : 0, numLimbs * sizeof(limb_t));
+    memset(bval, bvalBits ? 0xFF : 0, numLimbs * sizeof(limb_t));
+    if (avalBits || bvalBits) {
+        zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    }
+    unknown = bvalBits;
+}
+
+/**
+ * @brief Sets unknown field for vec4state.
+ * 
+ * Scans the vector and sets the unknown flag to true if encountered unknown values in the vector, and to false otherwise.
+ */
+void vec4state::setUnknown() {
+    for (int i = 0; i < numLimbs; i++) {
+        if (bval[i] != 0) {
+            unknown = true;
+            return;
+        }
+    }
+    unknown = false;
+}
+
+/**
+ * @brief Increment number of bits for vec4state.
+ * 
+ * Increments the number of bits in the vector to newNumBits by assigning a bigger limb array to this vector, copying the values from the original array to the new one, and zero-extending the new limbs in the new array. Throws vec4stateExceptionInvalidSize if newNumBits is less than the current number of bits or non-positive. If newNumBits is the same as the current number of bits, the vector remains unchanged.
+ * 
+ * @param newNumBits The new number of bits in the vector.
+ */
+void vec4state::incNumBits(long long newNumBits) {
+    if (newNumBits <= 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be positive");
+    }
+    if (newNumBits < numBits) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be greater than the current number of bits");
+    }
+    if (newNumBits == numBits) {
+        return;
+    }
+    numBits = newNumBits;
+    // If no need to add more limbs, leave the array as is.
+    if (calcNumLimbs(numBits) == numLimbs) {
+        return;
+    }
+    // Copy the values from the old array and zero-extend the new limbs.
+    resizeVector(calcNumLimbs(numBits));
+}
+
+/**
+ * @brief Truncate number of bits for vec4state.
+ * 
+ * Decreases the number of bits in the vector to newNumBits by assigning a smaller limb array to this vector, copying the values that are in the new range from the original array to the new one, and truncating the limbs that are not in the new range. Throws vec4stateExceptionInvalidSize if newNumBits is greater than the current number of bits or negative. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is 0, the vector is truncated to a single x bit.
+ * 
+ * @param newNumBits The new number of bits in the vector.
+ */
+void vec4state::decNumBits(long long newNumBits) {
+    if (newNumBits < 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be non-negative");
+    }
+    if (newNumBits > numBits) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be less than the current number of bits");
+    }
+    if (newNumBits == numBits) {
+        return;
+    }
+    if (newNumBits == 0) {
+        *this = vec4state(X, 1);
+        return;
+    }
+    long long indexLastCell = calcNumLimbs(newNumBits) - 1;
+    long long offset = newNumBits % BITS_IN_LIMB;
+    limb_t mask = MASK_LIMB >> (BITS_IN_LIMB - offset);
+    numBits = newNumBits;
+    // If no need to delete limbs, remove the unnecessary bits from the last limb.
+    if (numLimbs == indexLastCell + 1) {
+        if (offset != 0) {
+            makeUnique();
+            aval[indexLastCell] = aval[indexLastCell] & mask;
+            bval[indexLastCell] = bval[indexLastCell] & mask;
+        }
+        // If the new last cell still holds unknown bits, the vector holds unknown bits. Otherwise, if the vector was unknown before, check the rest of the vector.
+        if (bval[indexLastCell] != 0) {
+            unknown = true;
+        } else if (unknown) {
+            setUnknown();
+        }
+    }
+    // If need to remove limbs, shrink the array to the new size, keeping the values that are still in range.
+    else {
+        resizeVector(indexLastCell + 1);
+        // If the last cell needs to be truncated in the middle, extract the relevant bits.
+        if (offset != 0) {
+            aval[indexLastCell] = aval[indexLastCell] & mask;
+            bval[indexLastCell] = bval[indexLastCell] & mask;
+        }
+        // The removed cells might have held the only unknown bits.
+        setUnknown();
+    }
+}
+
+/**
+ * @brief Converts the vector to a 64-bit number without throwing exceptions.
+ * 
+ * Calculates the numerical value that the vector holds by combining its first 64 bits. If the vector has 1's after the 64th bit, NUMBER_TOO_LARGE is returned (even if it also has unknown bits). Otherwise, if the vector has unknown bits, NUMBER_UNKNOWN is returned. In both cases value is not changed. This is the decoder of shift amounts and bit indices, where an unknown or too large number is a normal case and not an error.
+ * 
+ * @param value The variable to write the number into.
+ * @return NUMBER_OK if the number was written into value, otherwise the reason that the vector can't be converted.
+ */
+NumberStatus vec4state::tryToUint64(uint64_t& value) const {
+    // If the vector has 1's after the 64th bit, the value is too large to be represented by 64 bits.
+    for (long long i = numLimbs - 1; i >= LIMBS_IN_INDEX_VECTOR; i--) {
+        if (aval[i] != 0) {
+            return NUMBER_TOO_LARGE;
+        }
+    }
+    // If the vector has unknown bits, the value cannot be calculated.
+    if (unknown) {
+        return NUMBER_UNKNOWN;
+    }
+    // Combine the limbs that hold the first 64 bits, each shifted to its position.
+    uint64_t result = 0;
+    for (long long i = min(numLimbs, (long long)(LIMBS_IN_INDEX_VECTOR)) - 1; i >= 0; i--) {
+        result |= uint64_t(aval[i]) << (i * BITS_IN_LIMB);
+    }
+    value = result;
+    return NUMBER_OK;
+}
+
+/**
+ * @brief Sets the number of bits to a new number for vec4state.
+ * 
+ * Sets the number of bits in the vector to newNumBits by truncating or extending the vector (using decNumBits / incNumBits, respectively). If newNumBits is less than the current number of bits, the vector is truncated. If newNumBits is greater than the current number of bits, the vector is zero-extended. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is negative, vec4stateExceptionInvalidSize is thrown.
+ * 
+ * @param newNumBits The new number of bits in the vector.
+ */
+void vec4state::setNumBits(long long newNumBits) {
+    if (newNumBits < 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be non-negative");
+    }
+    // If need to extend the vector
+    if (newNumBits > numBits) {
+        incNumBits(newNumBits);
+    }
+    // If need to truncate the vector
+    if (newNumBits < numBits) {
+        decNumBits(newNumBits);
+    }
+}
+
+/**
+ * @brief Default constructor for vec4state.
+ * 
+ * Initializes a 1-bit vector, initialized to x.
+ */
+vec4state::vec4state() : aval(nullptr), bval(nullptr) {
+    allocateVector(1);
+    numBits = 1;
+    aval[0] = 0;
+    bval[0] = 1;
+    unknown = true;
+}
+
+/**
+ * @brief Helper function for filling the vector with bits from a string.
+ * 
+ * The function iterates over the string's characters (starting from index startStrIndex), translates the BitValues to aval and bval of a limb, and fills the limb of vector at index limbIndex with these BitValues. The filling stops when cellSize bits are filled. If str contains invalid characters, vec4stateExceptionInvalidInput is thrown.
+ * 
+ * @param avalPlane The aval plane of the vector to fill.
+ * @param bvalPlane The bval plane of the vector to fill.
+ * @param str The string to read the bits from.
+ * @param cellSize The number of bits to fill in the limb.
+ * @param limbIndex The index of the limb in the vector to fill.
+ * @param startStrIndex The index of the first bit in the string to start reading from.
+ * @return The index of the next bit in the string.
+ */
+long long fillLimbWithStringBits(limb_t* avalPlane, limb_t* bvalPlane, const string& str, long long cellSize, long long limbIndex, long long startStrIndex) {
+    limb_t aval = 0;
+    limb_t bval = 0;
+    // Iterate over the string's characters and fill the limb with the bits until reaching cellSize.
+    long long currStrIndex = startStrIndex;
+    for (long long currBitIndex = 0; currBitIndex < cellSize; currBitIndex++) {
+        switch(str[currStrIndex]) {
+            // Translate the BitValues to aval and bval of the limb.
+            case ZERO:
+                break;
+            case ONE:
+                aval += 1;
+                break;
+            case X:
+                bval += 1;
+                break;
+            case Z:
+                aval += 1;
+                bval += 1;
+                break;
+            default:
+                throw vec4stateExceptionInvalidInput(string("Invalid bit: ") + str[currStrIndex] + " at index " + to_string(currStrIndex));
+        }
+        // If the current bit is not the last bit in the cell, shift the current values to the left to keep on adding.
+        if (currBitIndex < cellSize - 1) {
+            aval = aval << 1;
+            bval = bval << 1;
+        }
+        currStrIndex++;
+    }
+    avalPlane[limbIndex] = aval;
+    bvalPlane[limbIndex] = bval;
+    return currStrIndex;
+}
+
+#if SIMD_PARSE_WIDTH != 0
+/**
+ * @brief Classifies SIMD_PARSE_WIDTH characters of a string.
+ * 
+ * Compares the characters to the BitValues, and packs the results of the comparisons into masks (using movemask), where bit i of each mask belongs to the character at chars[i].
+ * 
+ * @param chars The characters to classify.
+ * @param avalMask Set to the mask of the characters that are 1 or z.
+ * @param bvalMask Set to the mask of the characters that are x or z.
+ * @return The mask of the characters that are BitValues.
+ */
+inline uint32_t classifyStringChars(const char* chars, uint32_t& avalMask, uint32_t& bvalMask) {
+#if SIMD_PARSE_WIDTH == 32
+    __m256i currChars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars));
+    __m256i isZero = _mm256_cmpeq_epi8(currChars, _mm256_set1_epi8(ZERO));
+    __m256i isOne = _mm256_cmpeq_epi8(currChars, _mm256_set1_epi8(ONE));
+    __m256i isX = _mm256_cmpeq_epi8(currChars, _mm256_set1_epi8(X));
+    __m256i isZ = _mm256_cmpeq_epi8(currChars, _mm256_set1_epi8(Z));
+    avalMask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(isOne, isZ)));
+    bvalMask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(isX, isZ)));
+    return uint32_t(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(isZero, isOne), _mm256_or_si256(isX, isZ))));
+#else
+    __m128i currChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+    __m128i isZero = _mm_cmpeq_epi8(currChars, _mm_set1_epi8(ZERO));
+    __m128i isOne = _mm_cmpeq_epi8(currChars, _mm_set1_epi8(ONE));
+    __m128i isX = _mm_cmpeq_epi8(currChars, _mm_set1_epi8(X));
+    __m128i isZ = _mm_cmpeq_epi8(currChars, _mm_set1_epi8(Z));
+    avalMask = uint32_t(_mm_movemask_epi8(_mm_or_si128(isOne, isZ)));
+    bvalMask = uint32_t(_mm_movemask_epi8(_mm_or_si128(isX, isZ)));
+    return uint32_t(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isZero, isOne), _mm_or_si128(isX, isZ))));
+#endif
+}
+
+/**
+ * @brief Reverses the order of the bits in a limb.
+ * 
+ * @param limb The limb to reverse.
+ * @return The limb, where bit i is bit BITS_IN_LIMB - 1 - i of the original limb.
+ */
+inline limb_t reverseLimbBits(limb_t limb) {
+    uint64_t bits = limb;
+    bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+    bits = ((bits >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((bits & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    bits = ((bits >> 8) & 0x00FF00FF00FF00FFULL) | ((bits & 0x00FF00FF00FF00FFULL) << 8);
+    bits = ((bits >> 16) & 0x0000FFFF0000FFFFULL) | ((bits & 0x0000FFFF0000FFFFULL) << 16);
+    bits = (bits >> 32) | (bits << 32);
+    return limb_t(bits >> (64 - BITS_IN_LIMB));
+}
+#endif
+
+/**
+ * @brief Helper function for filling a whole limb of the vector with bits from a string.
+ * 
+ * Fills the limb of the vector at index limbIndex with the BITS_IN_LIMB characters of str that start at index startStrIndex, with the same result as fillLimbWithStringBits. Where SSE2 or AVX2 is available, the characters are classified SIMD_PARSE_WIDTH at a time (using classifyStringChars), and the masks are reversed into the limb, because the string holds the most significant bit first. Otherwise, the function falls back to fillLimbWithStringBits. If str contains invalid characters, vec4stateExceptionInvalidInput is thrown with the index of the first invalid character.
+ * 
+ * @param avalPlane The aval plane of the vector to fill.
+ * @param bvalPlane The bval plane of the vector to fill.
+ * @param str The string to read the bits from.
+ * @param limbIndex The index of the limb in the vector to fill.
+ * @param startStrIndex The index of the first bit in the string to start reading from.
+ * @return The index of the next bit in the string.
+ */
+long long fillFullLimbWithStringBits(limb_t* avalPlane, limb_t* bvalPlane, const string& str, long long limbIndex, long long startStrIndex) {
+#if SIMD_PARSE_WIDTH != 0
+    const char* chars = str.data() + startStrIndex;
+    uint64_t aval = 0;
+    uint64_t bval = 0;
+    for (int offset = 0; offset < BITS_IN_LIMB; offset += SIMD_PARSE_WIDTH) {
+        uint32_t avalMask, bvalMask;
+        uint32_t validMask = classifyStringChars(chars + offset, avalMask, bvalMask);
+        if (validMask != uint32_t((uint64_t(1) << SIMD_PARSE_WIDTH) - 1)) {
+            // Find the first character that is not a BitValue.
+            long long invalidIndex = startStrIndex + offset;
+            while ((validMask & 1) != 0) {
+                validMask >>= 1;
+                invalidIndex++;
+            }
+            throw vec4stateExceptionInvalidInput(string("Invalid bit: ") + str[invalidIndex] + " at index " + to_string(invalidIndex));
+        }
+        aval |= uint64_t(avalMask) << offset;
+        bval |= uint64_t(bvalMask) << offset;
+    }
+    // The first character is the most significant bit of the limb.
+    avalPlane[limbIndex] = reverseLimbBits(limb_t(aval));
+    bvalPlane[limbIndex] = reverseLimbBits(limb_t(bval));
+    return startStrIndex + BITS_IN_LIMB;
+#else
+    return fillLimbWithStringBits(avalPlane, bvalPlane, str, BITS_IN_LIMB, limbIndex, startStrIndex);
+#endif
+}
+
+/**
+ * @brief Bit constructor for vec4state.
+ * 
+ * Initializes a vector that holds bit of size 1. If bit is a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown.
+ * 
+ * @param bit The bit to initialize the vector with, must be a BitValue.
+ */
+vec4state::vec4state(char bit) : vec4state() {
+    fill(BitValue(bit));
+}
+
+/**
+ * @brief String constructor for vec4state.
+ * 
+ * Initializes a vector of size str.length() with the values represented by str. The constructor translates the string's characters to aval and bval of a limb, and fills the limb of vector from last limb to first limb with these BitValues. Whole limbs are classified 16 or 32 characters at a time where SSE2 or AVX2 is available (using fillFullLimbWithStringBits). If str contains a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown, with the index of the first invalid character in its message.
+ * 
+ * @param str The value to initialize the vector with, must be a string that holds only BitValues.
+ */
+vec4state::vec4state(string str) : vec4state() {
+    // If the string is empty, creates a default vector.
+    if (str.length() == 0) {
+        return;
+    }
+    numBits = str.length();
+    allocateVector(calcNumLimbs(numBits));
+    // For each limb in the vector, fill it with the bits from the string.
+    int numUndividedBits = numBits % BITS_IN_LIMB;
+    long long currStrIndex = 0;
+    for (long long currLimbIndex = numLimbs - 1; currLimbIndex >= 0; currLimbIndex--) {
+        // The constructor reads the string's characters from the MSB to the LSB, therefore if the string's length doesn't divide by BITS_IN_LIMB, then the last limb (where the MSBs are stored) needs alignment to BITS_IN_LIMB bits (by zero-extension).
+        if (currLimbIndex == numLimbs - 1 && numUndividedBits != 0) {
+            currStrIndex = fillLimbWithStringBits(aval, bval, str, numUndividedBits, currLimbIndex, 0);
+        }
+        // For the rest of the limbs in the vector, fill them with the bits from the string a whole limb at a time.
+        else {
+            currStrIndex = fillFullLimbWithStringBits(aval, bval, str, currLimbIndex, currStrIndex);
+        }
+    }
+    setUnknown();
+}
+
+/**
+ * @brief Throws the exception of an invalid literal.
+ * 
+ * @param literal The literal that is parsed.
+ * @param index The index of the invalid character in the literal.
+ */
+[[noreturn]] void throwInvalidLiteral(const string& literal, size_t index) {
+    throw vec4stateExceptionInvalidInput("Invalid literal: " + literal + " at index " + to_string(index));
+}
+
+/**
+ * @brief A lookup table of the values of the digits of a literal.
+ */
+struct LiteralDigitTable {
+    /**
+     * @brief The value of every character: 0 to 15 for a hexadecimal digit, LITERAL_DIGIT_X for x/X, LITERAL_DIGIT_Z for z/Z/?, or -1 if the character is not a digit.
+     */
+    signed char values[256];
+
+    /**
+     * @brief Fills the values of the table.
+     */
+    LiteralDigitTable() {
+        memset(values, -1, sizeof(values));
+        for (int digit = 0; digit < 10; digit++) {
+            values['0' + digit] = digit;
+        }
+        for (int digit = 10; digit < 16; digit++) {
+            values['a' + digit - 10] = digit;
+            values['A' + digit - 10] = digit;
+        }
+        values['x'] = values['X'] = LITERAL_DIGIT_X;
+        values['z'] = values['Z'] = values['?'] = LITERAL_DIGIT_Z;
+    }
+
+    /**
+     * @brief The value of a character.
+     * 
+     * @param digit The character.
+     * @return The value of the character in the table.
+     */
+    int operator[](char digit) const {
+        return values[uint8_t(digit)];
+    }
+};
+
+/**
+ * @brief Multiplies a number that is stored in limbs by a limb and adds a limb to it.
+ * 
+ * Calculates limbs * factor + addend in place, where the carry out of the last limb is discarded.
+ * 
+ * @param limbs The limbs of the number, from the least significant limb.
+ * @param numLimbs The number of limbs in limbs.
+ * @param factor The limb to multiply by.
+ * @param addend The limb to add.
+ */
+void multiplyAddLimb(limb_t* limbs, long long numLimbs, limb_t factor, limb_t addend) {
+    limb_t carry = addend;
+    for (long long i = 0; i < numLimbs; i++) {
+        limb_t high;
+        limb_t low = mulWide(limbs[i], factor, high);
+        limb_t carryOut;
+        limbs[i] = addWithCarry(low, carry, 0, carryOut);
+        carry = high + carryOut;
+    }
+}
+
+/**
+ * @brief Creates a vector from a SystemVerilog integer literal.
+ * 
+ * Parses sized and unsized literals, such as 8'hFF, 16'b1x0z, 12'o7_7?, 4'sd5, 'd123, 123 and '1, and builds the aval and bval limbs directly from the digits, without an intermediate binary string. The size is followed by ', an optional s (signedness, which is accepted but doesn't change the bits of the vector), and the base b, o, d or h (case insensitive). Digits can be x/X, z/Z or ?, and underscores between the digits are ignored. As in SystemVerilog:
+ * - A sized literal that has more bits than its size is truncated from the left, and a literal that has fewer bits is zero-extended, or extended with x's or z's if its leftmost digit is x or z.
+ * - An unsized literal (based or decimal) has at least 32 bits, and more if its digits need them.
+ * - A decimal literal can have a single x or z digit, which sets all of its bits.
+ * - An unbased unsized literal ('0, '1, 'x or 'z) is a 1-bit vector, which is its self-determined size.
+ * 
+ * If the literal is malformed, vec4stateExceptionInvalidInput is thrown with the index of the first invalid character, and if its size is 0, vec4stateExceptionInvalidSize is thrown.
+ * 
+ * @param literal The literal to parse.
+ * @return A vector that holds the value of the literal.
+ */
+vec4state vec4state::fromLiteral(const string& literal) {
+    static const LiteralDigitTable digitTable;
+    const char* chars = literal.data();
+    size_t length = literal.length();
+    size_t pos = 0;
+    // Read the size, or the digits of an unsized decimal literal.
+    long long size = 0;
+    bool hasSize = false;
+    while (pos < length && ((chars[pos] >= '0' && chars[pos] <= '9') || (hasSize && chars[pos] == '_'))) {
+        if (chars[pos] != '_' && size <= LITERAL_MAX_SIZE) {
+            size = size * 10 + (chars[pos] - '0');
+        }
+        hasSize = true;
+        pos++;
+    }
+    size_t sizeEnd = pos;
+    while (pos < length && chars[pos] == ' ') {
+        pos++;
+    }
+    int bitsInDigit = 0;
+    int radix = 10;
+    size_t digitsStart = 0;
+    if (pos < length && chars[pos] == '\'') {
+        pos++;
+        int digit = (pos + 1 == length) ? digitTable[chars[pos]] : -1;
+        if (!hasSize && (digit == 0 || digit == 1 || digit >= LITERAL_DIGIT_X)) {
+            // An unbased unsized literal is a single bit.
+            return vec4state(digit == 0 ? ZERO : (digit == 1 ? ONE : (digit == LITERAL_DIGIT_X ? X : Z)), 1);
+        }
+        if (pos < length && (chars[pos] == 's' || chars[pos] == 'S')) {
+            pos++;
+        }
+        if (pos == length) {
+            throwInvalidLiteral(literal, pos);
+        }
+        switch (chars[pos]) {
+            case 'b': case 'B':
+                bitsInDigit = 1;
+                radix = 2;
+                break;
+            case 'o': case 'O':
+                bitsInDigit = 3;
+                radix = 8;
+                break;
+            case 'd': case 'D':
+                radix = 10;
+                break;
+            case 'h': case 'H':
+                bitsInDigit = 4;
+                radix = 16;
+                break;
+            default:
+                throwInvalidLiteral(literal, pos);
+        }
+        pos++;
+        while (pos < length && chars[pos] == ' ') {
+            pos++;
+        }
+        digitsStart = pos;
+    } else {
+        // A literal without a base is an unsized decimal number, which was read as the size.
+        if (!hasSize || pos != length) {
+            throwInvalidLiteral(literal, hasSize ? sizeEnd : 0);
+        }
+        hasSize = false;
+        digitsStart = 0;
+        length = sizeEnd;
+    }
+    if (hasSize && (size == 0 || size > LITERAL_MAX_SIZE)) {
+        throw vec4stateExceptionInvalidSize("Invalid literal size: " + literal);
+    }
+    // Check the digits and count them, where the first digit can't be an underscore.
+    long long numDigits = 0;
+    int leftmostDigit = -1;
+    for (size_t i = digitsStart; i < length; i++) {
+        if (chars[i] == '_' && numDigits > 0) {
+            continue;
+        }
+        int digit = digitTable[chars[i]];
+        if (digit < 0 || (digit >= radix && digit < LITERAL_DIGIT_X)) {
+            throwInvalidLiteral(literal, i);
+        }
+        if (leftmostDigit < 0) {
+            leftmostDigit = digit;
+        }
+        numDigits++;
+    }
+    if (numDigits == 0) {
+        throwInvalidLiteral(literal, length);
+    }
+    if (radix == 10) {
+        // A decimal literal is either a single x or z digit, or a number.
+        if (leftmostDigit >= LITERAL_DIGIT_X) {
+            if (numDigits != 1) {
+                throwInvalidLiteral(literal, digitsStart);
+            }
+            return vec4state(leftmostDigit == LITERAL_DIGIT_X ? X : Z, hasSize ? size : LITERAL_UNSIZED_BITS);
+        }
+        for (size_t i = digitsStart; i < length; i++) {
+            if (chars[i] != '_' && digitTable[chars[i]] >= LITERAL_DIGIT_X) {
+                throwInvalidLiteral(literal, i);
+            }
+        }
+        // log2(10) < 3.33, so the number of digits bounds the number of bits of the value from above.
+        long long valueNumLimbs = calcNumLimbs(numDigits * 333 / 100 + 1);
+        long long bufferNumLimbs = hasSize ? max(valueNumLimbs, calcNumLimbs(size)) : valueNumLimbs;
+        // Small values are accumulated on the stack, so no memory is allocated for them.
+        limb_t inlineValue[INLINE_NUM_LIMBS] = {};
+        unique_ptr<limb_t[]> heapValue;
+        if (bufferNumLimbs > INLINE_NUM_LIMBS) {
+            heapValue.reset(new limb_t[bufferNumLimbs]());
+        }
+        limb_t* value = heapValue ? heapValue.get() : inlineValue;
+        // Accumulate the digits DECIMAL_DIGITS_IN_CHUNK at a time.
+        limb_t chunk = 0;
+        limb_t chunkFactor = 1;
+        for (size_t i = digitsStart; i < length; i++) {
+            if (chars[i] == '_') {
+                continue;
+            }
+            chunk = chunk * 10 + limb_t(chars[i] - '0');
+            chunkFactor *= 10;
+            if (chunkFactor == DECIMAL_CHUNK) {
+                multiplyAddLimb(value, bufferNumLimbs, chunkFactor, chunk);
+                chunk = 0;
+                chunkFactor = 1;
+            }
+        }
+        if (chunkFactor != 1) {
+            multiplyAddLimb(value, bufferNumLimbs, chunkFactor, chunk);
+        }
+        long long numBits = size;
+        if (!hasSize) {
+            long long usedNumLimbs = bufferNumLimbs;
+            while (usedNumLimbs > 0 && value[usedNumLimbs - 1] == 0) {
+                usedNumLimbs--;
+            }
+            long long valueNumBits = usedNumLimbs == 0 ? 0 : usedNumLimbs * BITS_IN_LIMB - countLeadingZeros(value[usedNumLimbs - 1]);
+            numBits = max<long long>(LITERAL_UNSIZED_BITS, valueNumBits);
+        }
+        vec4state result(numBits, NO_INIT);
+        for (long long i = 0; i < result.numLimbs; i++) {
+            result.aval[i] = value[i];
+            result.bval[i] = 0;
+        }
+        zeroDownOutOfRangeBits(result.aval, result.bval, result.numLimbs, result.numBits);
+        return result;
+    }
+    long long numBits = hasSize ? size : max<long long>(LITERAL_UNSIZED_BITS, numDigits * bitsInDigit);
+    vec4state result(numBits, NO_INIT);
+    limb_t* resultAval = result.aval;
+    limb_t* resultBval = result.bval;
+    long long resultNumLimbs = result.numLimbs;
+    // Write the digits from the least significant digit into a limb that is kept in registers, until the bits are out of range.
+    limb_t digitMask = (limb_t(1) << bitsInDigit) - 1;
+    limb_t currAval = 0;
+    limb_t currBval = 0;
+    long long limbIndex = 0;
+    int offset = 0;
+    for (size_t i = length; i > digitsStart && limbIndex < resultNumLimbs; i--) {
+        if (chars[i - 1] == '_') {
+            continue;
+        }
+        int digit = digitTable[chars[i - 1]];
+        limb_t digitAval = (digit == LITERAL_DIGIT_X) ? 0 : ((digit == LITERAL_DIGIT_Z) ? digitMask : limb_t(digit));
+        limb_t digitBval = (digit >= LITERAL_DIGIT_X) ? digitMask : 0;
+        currAval |= digitAval << offset;
+        currBval |= digitBval << offset;
+        offset += bitsInDigit;
+        if (offset >= BITS_IN_LIMB) {
+            resultAval[limbIndex] = currAval;
+            resultBval[limbIndex] = currBval;
+            limbIndex++;
+            offset -= BITS_IN_LIMB;
+            // An octal digit might continue in the next limb.
+            currAval = (offset > 0) ? digitAval >> (bitsInDigit - offset) : 0;
+            currBval = (offset > 0) ? digitBval >> (bitsInDigit - offset) : 0;
+        }
+    }
+    long long bit = limbIndex * BITS_IN_LIMB + offset;
+    if (limbIndex < resultNumLimbs) {
+        resultAval[limbIndex] = currAval;
+        resultBval[limbIndex] = currBval;
+        for (long long i = limbIndex + 1; i < resultNumLimbs; i++) {
+            resultAval[i] = 0;
+            resultBval[i] = 0;
+        }
+    }
+    // If the leftmost digit is x or z, the bits to its left are extended with it.
+    if (leftmostDigit >= LITERAL_DIGIT_X && bit < numBits) {
+        for (long long i = bit / BITS_IN_LIMB; i < resultNumLimbs; i++) {
+            limb_t extensionMask = (i == bit / BITS_IN_LIMB) ? MASK_LIMB << (bit % BITS_IN_LIMB) : MASK_LIMB;
+            resultBval[i] |= extensionMask;
+            if (leftmostDigit == LITERAL_DIGIT_Z) {
+                resultAval[i] |= extensionMask;
+            }
+        }
+    }
+    zeroDownOutOfRangeBits(resultAval, resultBval, resultNumLimbs, numBits);
+    result.setUnknown();
+    return result;
+}
+
+/**
+ * @brief Fill constructor for vec4state.
+ * 
+ * Initializes a vector with a single bit (that can be either 0, 1, x, or z) repeated numBits times. The limbs are filled directly with the aval and bval words of bit (using fill), so creating the vector takes time proportional to the number of limbs. If numBits is non-positive or bit is not a BitValue, vec4stateExceptionInvalidSize or vec4stateExceptionInvalidInput is thrown, respectively.
+ * 
+ * @param bit The bit to repeat.
+ * @param numBits The number of bits in the vector.
+ */
+vec4state::vec4state(BitValue bit, long long numBits) : aval(nullptr), bval(nullptr) {
+    if (bit != ZERO && bit != ONE && bit != X && bit != Z) {
+        throw vec4stateExceptionInvalidInput("Invalid bit");
+    }
+    if (numBits <= 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be greater than 0");
+    }
+    this->numBits = numBits;
+    allocateVector(calcNumLimbs(numBits));
+    fill(bit);
+}
+
+/**
+ * @brief Uninitialized constructor for vec4state.
+ * 
+ * Initializes a known vector of numBits bits without initializing its limbs. Used internally by operators that overwrite every limb of the result.
+ * 
+ * @param numBits The number of bits in the vector.
+ */
+vec4state::vec4state(long long numBits, NoInit) : aval(nullptr), bval(nullptr), numBits(numBits), unknown(false) {
+    allocateVector(calcNumLimbs(numBits));
+}
+
+/**
+ * @brief Copy constructor for vec4state.
+ * 
+ * Initializes a new vector that holds the values of the other vector. If the other vector is stored on the heap, the new vector shares its planes (copy-on-write), and the planes are cloned only when one of the vectors is changed. Otherwise, the limbs are copied to the inline storage of the new vector.
+ * 
+ * @param other The vector to copy from.
+ */
+vec4state::vec4state(const vec4state& other) : aval(nullptr), bval(nullptr), numBits(other.numBits), numLimbs(other.numLimbs), unknown(other.unknown) {
+    if (other.heapPlanes) {
+        heapPlanes = other.heapPlanes;
+        capacity = other.capacity;
+        aval = other.aval;
+        bval = other.bval;
+        return;
+    }
+    allocateVector(other.numLimbs);
+    for (long long i = 0; i < numLimbs; i++) {
+        aval[i] = other.aval[i];
+        bval[i] = other.bval[i];
+    }
+}
+
+/**
+ * @brief Move constructor for vec4state.
+ * 
+ * Initializes a new vector with the same values as other, and transfers the ownership of the vector to the new object. The other vector is left in a valid but unspecified state.
+ * 
+ * @param other The vector to move from.
+ */
+vec4state::vec4state(vec4state&& other) noexcept : aval(other.aval), bval(other.bval), heapPlanes(move(other.heapPlanes)), numBits(other.numBits), numLimbs(other.numLimbs), capacity(other.capacity), unknown(other.unknown) {
+    // Inline planes can't be transferred, so their limbs are copied.
+    if (other.aval == other.inlineAval) {
+        for (long long i = 0; i < numLimbs; i++) {
+            inlineAval[i] = other.inlineAval[i];
+            inlineBval[i] = other.inlineBval[i];
+        }
+        aval = inlineAval;
+        bval = inlineBval;
+    }
+    other.aval = nullptr;
+    other.bval = nullptr;
+}
+
+/**
+ * @brief Assignment operator for vec4state.
+ * 
+ * Assigns the values of other to this vector. If the other vector is shorter than this vector, zeroes down the bits that are out of range. If both vectors have the same number of bits and other vector is stored on the heap, this vector shares the planes of other vector (copy-on-write).
+ * 
+ * @param other The vector to assign from.
+ * @return A reference to this vector.
+ */
+vec4state& vec4state::operator=(const vec4state& other) {
+    if (this == &other) {
+        return *this;
+    }
+    // If the vectors have the same size, share the planes instead of copying them.
+    if (numBits == other.numBits && other.heapPlanes) {
+        heapPlanes = other.heapPlanes;
+        aval = other.aval;
+        bval = other.bval;
+        numLimbs = other.numLimbs;
+        capacity = other.capacity;
+        unknown = other.unknown;
+        return *this;
+    }
+    makeUnique();
+    // Setting this vector's bits to the other vector's bits.
+    for (long long i = 0; i < min(this->numLimbs, other.numLimbs); i++) {
+        aval[i] = other.aval[i];
+        bval[i] = other.bval[i];
+    }
+    // In case the other vector is shorter than this vector, put 0's in the remaining cells.
+    if (other.numLimbs < numLimbs) {
+        for (long long i = other.numLimbs; i < numLimbs; i++) {
+            aval[i] = 0;
+            bval[i] = 0;
+        }
+    }
+    // Zero down the bits that are out of range.
+    if (numBits % BITS_IN_LIMB != 0) {
+        aval[numLimbs - 1] = aval[numLimbs - 1] & (MASK_LIMB >> (BITS_IN_LIMB - (numBits % BITS_IN_LIMB)));
+        bval[numLimbs - 1] = bval[numLimbs - 1] & (MASK_LIMB >> (BITS_IN_LIMB - (numBits % BITS_IN_LIMB)));
+    }
+    // This vector has unknown bits only if the bits of the other vector that are in range are unknown, so unknown is checked after zeroing down the bits that are out of range.
+    unknown = false;
+    for (long long i = 0; i < numLimbs; i++) {
+        if (bval[i] != 0) {
+            unknown = true;
+            break;
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Bitwise AND operator for vec4state.
+ * 
+ * Calculates the bitwise AND of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors and calculates the aval and bval of each limb of the result directly (using v4::band).
+ * 
+ * @param other The vector to perform the bitwise AND operation with.
+ * @return A new vector that holds the result of the bitwise AND operation.
+ */
+vec4state vec4state::operator&(const vec4state& other) const& {
+    vec4state result;
+    v4::band(result, *this, other);
+    return result;
+}
+
+/**
+ * @brief Bitwise AND operator for an expiring vec4state.
+ * 
+ * Calculates the bitwise AND of this vector and other vector (as in operator&), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator&=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+ * 
+ * @param other The vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator&(const vec4state& other) && {
+    // The result is wider than this vector, so it can't be calculated in place.
+    if (numBits < other.numBits) {
+        return *this & other;
+    }
+    return move(*this &= other);
+}
+
+/**
+ * @brief Bitwise AND operator for vec4state with an expiring vector.
+ * 
+ * Calculates the bitwise AND of this vector and other vector (as in operator&), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator&(vec4state&& other) const& {
+    return move(other) & *this;
+}
+
+/**
+ * @brief Bitwise AND operator for two expiring vec4state vectors.
+ * 
+ * Calculates the bitwise AND of this vector and other vector (as in operator&), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator&(vec4state&& other) && {
+    if (numBits >= other.numBits) {
+        return move(*this) & other;
+    }
+    return move(other) & *this;
+}
+
+/**
+ * @brief Bitwise OR operator for vec4state.
+ * 
+ * Calculates the bitwise OR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 1, the result bit is 1.
+ * If both bits are 0, the result bit is 0. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector.
+ * 
+ * @param other The vector to perform the bitwise OR operation with.
+ * @return A new vector that holds the result of the bitwise OR operation.
+ */
+vec4state vec4state::operator|(const vec4state& other) const& {
+    vec4state result;
+    v4::bor(result, *this, other);
+    return result;
+}
+
+/**
+ * @brief Bitwise OR operator for an expiring vec4state.
+ * 
+ * Calculates the bitwise OR of this vector and other vector (as in operator|), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator|=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+ * 
+ * @param other The vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator|(const vec4state& other) && {
+    // The result is wider than this vector, so it can't be calculated in place.
+    if (numBits < other.numBits) {
+        return *this | other;
+    }
+    return move(*this |= other);
+}
+
+/**
+ * @brief Bitwise OR operator for vec4state with an expiring vector.
+ * 
+ * Calculates the bitwise OR of this vector and other vector (as in operator|), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator|(vec4state&& other) const& {
+    return move(other) | *this;
+}
+
+/**
+ * @brief Bitwise OR operator for two expiring vec4state vectors.
+ * 
+ * Calculates the bitwise OR of this vector and other vector (as in operator|), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator|(vec4state&& other) && {
+    if (numBits >= other.numBits) {
+        return move(*this) | other;
+    }
+    return move(other) | *this;
+}
+
+/**
+ * @brief Bitwise XOR or XNOR of the vectors into a destination vector.
+ * 
+ * Calculates the bitwise XOR (or XNOR, if isXnor is true) of first and second into dst in a single pass over their limbs. If at least one of the bits is unknown, the result bit is x. Otherwise, the result bit is the XOR (or XNOR) of the known bits. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. dst may be one of the vectors.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ * @param isXnor true to calculate the bitwise XNOR, false to calculate the bitwise XOR.
+ */
+void vec4state::bitwiseXorXnor(vec4state& dst, const vec4state& first, const vec4state& second, bool isXnor) {
+    // If dst is one of the vectors, its values are kept (and zero-extended), so that the vector is read correctly after it is resized.
+    dst.reshape(max(first.numBits, second.numBits), &dst == &first || &dst == &second);
+    const vec4state& shorter = (first.numLimbs <= second.numLimbs) ? first : second;
+    const vec4state& longer = (first.numLimbs <= second.numLimbs) ? second : first;
+    const limb_t* longerAval = longer.aval;
+    const limb_t* longerBval = longer.bval;
+    const limb_t* shorterAval = shorter.aval;
+    const limb_t* shorterBval = shorter.bval;
+    limb_t* resultAval = dst.aval;
+    limb_t* resultBval = dst.bval;
+    // XNOR is XOR with every known result bit flipped.
+    limb_t invertMask = isXnor ? MASK_LIMB : 0;
+    limb_t unknownBits = 0;
+    // An unknown bit in one of the vectors makes the result bit unknown.
+    for (long long i = 0; i < shorter.numLimbs; i++) {
+        limb_t currBval = longerBval[i] | shorterBval[i];
+        resultAval[i] = (longerAval[i] ^ shorterAval[i] ^ invertMask) & ~currBval;
+        resultBval[i] = currBval;
+        unknownBits |= currBval;
+    }
+    // The shorter vector is zero-extended, so the rest of the longer vector is XORed with 0's (which turns z's into x's).
+    for (long long i = shorter.numLimbs; i < longer.numLimbs; i++) {
+        resultAval[i] = (longerAval[i] ^ invertMask) & ~longerBval[i];
+        resultBval[i] = longerBval[i];
+        unknownBits |= longerBval[i];
+    }
+    // Flipping the known bits sets the bits that are out of range.
+    if (isXnor) {
+        zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+    }
+    dst.unknown = unknownBits != 0;
+}
+
+/**
+ * @brief Bitwise XOR operator for vec4state.
+ * 
+ * Calculates the bitwise XOR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
+ * 
+ * @param other The vector to perform the bitwise XOR operation with.
+ * @return A new vector that holds the result of the bitwise XOR operation.
+ */
+vec4state vec4state::operator^(const vec4state& other) const& {
+    vec4state result;
+    v4::bxor(result, *this, other);
+    return result;
+}
+
+/**
+ * @brief Bitwise XOR operator for an expiring vec4state.
+ * 
+ * Calculates the bitwise XOR of this vector and other vector (as in operator^), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator^=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+ * 
+ * @param other The vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator^(const vec4state& other) && {
+    // The result is wider than this vector, so it can't be calculated in place.
+    if (numBits < other.numBits) {
+        return *this ^ other;
+    }
+    return move(*this ^= other);
+}
+
+/**
+ * @brief Bitwise XOR operator for vec4state with an expiring vector.
+ * 
+ * Calculates the bitwise XOR of this vector and other vector (as in operator^), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator^(vec4state&& other) const& {
+    return move(other) ^ *this;
+}
+
+/**
+ * @brief Bitwise XOR operator for two expiring vec4state vectors.
+ * 
+ * Calculates the bitwise XOR of this vector and other vector (as in operator^), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator^(vec4state&& other) && {
+    if (numBits >= other.numBits) {
+        return move(*this) ^ other;
+    }
+    return move(other) ^ *this;
+}
+
+/**
+ * @brief Bitwise XNOR operator for vec4state.
+ * 
+ * Calculates the bitwise XNOR (~^ in SystemVerilog) of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 1. If the two bits are not equal, the result bit is 0. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
+ * 
+ * @param other The vector to perform the bitwise XNOR operation with.
+ * @return A new vector that holds the result of the bitwise XNOR operation.
+ */
+vec4state vec4state::xnor(const vec4state& other) const {
+    vec4state result;
+    v4::bxnor(result, *this, other);
+    return result;
+}
+
+/**
+ * @brief Bitwise NOT operator for vec4state.
+ * 
+ * Calculates the bitwise NOT of each bit in the vector, resulting in one bit for each bit of the vector. If the bit is 0, the result bit is 1. If the bit is 1, the result bit is 0. If the bit is unknown, the result bit is x. The method iterates over the vector's limbs, and sets each bit in the aval to 1 only if the corresponding bit in the original vector is 0 (in any other case, the bit is set to 0, which means it can be either 0 or x). The bval stays the same (which means every known bit stays known and every unknown bit can be only x). Then the method zeroes down the bits that are out of range (because they have been set to 1 in the bitwise NOT).
+ * 
+ * @return A new vector that holds the result of the bitwise NOT operation.
+ */
+vec4state vec4state::operator~() const& {
+    vec4state result;
+    v4::bnot(result, *this);
+    return result;
+}
+
+/**
+ * @brief Bitwise NOT operator for an expiring vec4state.
+ * 
+ * Calculates the bitwise NOT of each bit in the vector (as in operator~), where this vector is a temporary that is not used after the operation. The result is calculated in place in the limbs of this vector and this vector is moved into the result, so no memory is allocated.
+ * 
+ * @return A vector that holds the result of the bitwise NOT operation.
+ */
+vec4state vec4state::operator~() && {
+    makeUnique();
+    for (long long i = 0; i < numLimbs; i++) {
+        aval[i] = ~(aval[i] | bval[i]);
+    }
+    zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    return move(*this);
+}
+
+/**
+ * @brief Logical equality of the vectors.
+ * 
+ * Compares this vector to other vector bit for bit in a single pass over their limbs, where the limbs that are out of range of the shorter vector are 0. The method stops at the first limb that holds a known bit that is different in the two vectors, so the cost depends on the position of the first difference rather than on the size of the vectors.
+ * 
+ * @param other The vector to compare to.
+ * @return ZERO if the vectors hold a known bit that is different.
+ * @return ONE if the vectors are equal.
+ * @return X if the comparison is ambiguous (due to unknown bits in one of the vectors).
+ */
+BitValue vec4state::logicalEquality(const vec4state& other) const {
+    const vec4state& shorter = (numLimbs <= other.numLimbs) ? *this : other;
+    const vec4state& longer = (numLimbs <= other.numLimbs) ? other : *this;
+    limb_t unknownBits = 0;
+    for (long long i = 0; i < shorter.numLimbs; i++) {
+        limb_t currBval = longer.bval[i] | shorter.bval[i];
+        // A known bit that is different in the two vectors decides the comparison.
+        if (((longer.aval[i] ^ shorter.aval[i]) & ~currBval) != 0) {
+            return ZERO;
+        }
+        unknownBits |= currBval;
+    }
+    // The rest of the longer vector is compared to 0's.
+    for (long long i = shorter.numLimbs; i < longer.numLimbs; i++) {
+        if ((longer.aval[i] & ~longer.bval[i]) != 0) {
+            return ZERO;
+        }
+        unknownBits |= longer.bval[i];
+    }
+    return (unknownBits != 0) ? X : ONE;
+}
+
+/**
+ * @brief Logical equality operator for vec4state.
+ * 
+ * Compares this vector to other vector bit for bit (using logicalEquality), without building a temporary vector. If the vectors hold at least one known bit that is different, the vectors are not equal. Otherwise, if one of the vectors has unknown bits, the comparison is ambiguous and the method returns x. In any other case, the vectors are equal.
+ * 
+ * @param other The vector to compare to.
+ * @return 1'b0 if the comparison fails.
+ * @return 1'b1 if the comparison succeeds.
+ * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+ */
+vec4state vec4state::operator==(const vec4state& other) const {
+    return vec4state(logicalEquality(other), 1);
+}
+
+/**
+ * @brief Logical inequality operator for vec4state.
+ * 
+ * Compares this vector to other vector bit for bit (using logicalEquality), and then negates the result.
+ * 
+ * @param other The vector to compare to.
+ * @return 1'b1 if the comparison fails.
+ * @return 1'b0 if the comparison succeeds.
+ * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+ */
+vec4state vec4state::operator!=(const vec4state& other) const {
+    BitValue equality = logicalEquality(other);
+    if (equality == X) {
+        return vec4state(X, 1);
+    }
+    return vec4state((equality == ONE) ? ZERO : ONE, 1);
+}
+
+/**
+ * @brief Case equality operator for vec4state.
+ * 
+ * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' limbs, and checks if the aval and bval of each limb are equal. If at least one of the limbs is not equal, the vectors are not equal. If all of the limbs are equal, the vectors are equal.
+ * 
+ * @param other The vector to compare to.
+ * @return 1'b0 if the comparison fails.
+ * @return 1'b1 if the comparison succeeds.
+ */
+vec4state vec4state::caseEquality(const vec4state& other) const {
+    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
+    if (numBits < other.numBits) {
+        vec4state copyThis = *this;
+        copyThis.setNumBits(other.numBits);
+        return copyThis.caseEquality(other);
+    } else if (numBits > other.numBits) {
+        vec4state copyOther = other;
+        copyOther.setNumBits(numBits);
+        return this->caseEquality(copyOther);
+    }
+    // Iterate over the vectors' limbs and check if the aval and bval of each limb are equal.
+    else {
+        for (int i = 0; i < numLimbs; i++) {
+        if (aval[i] != other.aval[i] || bval[i] != other.bval[i]) {
+            return vec4state(ZERO, 1);
+        }
+    }
+    return vec4state(ONE, 1);
+    }
+}
+
+/**
+ * @brief Case inequality operator for vec4state.
+ * 
+ * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall not match for the result to be considered unequal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method calculates the case equality of the vectors and then negates the result.
+ * 
+ * @param other The vector to compare to.
+ * @return 1'b1 if the comparison fails.
+ * @return 1'b0 if the comparison succeeds.
+ */
+vec4state vec4state::caseInequality(const vec4state& other) const {
+    return !caseEquality(other);
+}
+
+/**
+ * @brief Logical shift left operator for vec4state.
+ * 
+ * Extracts the value stored in other vector, then shifts this vector to the left by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, the result is a vector of 0's.
+ * 
+ * @param other The vector that holds the number of bit positions to shift by.
+ * @return A new vector that holds the result of the logical shift left operation. If other vector holds unknown bits, then the result is only x's.
+ */
+vec4state vec4state::operator<<(const vec4state& other) const& {
+    uint64_t num = 0;
+    NumberStatus status = other.tryToUint64(num);
+    if (status == NUMBER_UNKNOWN) {
+        return vec4state(X, numBits);
+    }
+    if (status == NUMBER_TOO_LARGE) {
+        return vec4state(ZERO, numBits);
+    }
+    vec4state result = *this << (long long)(num);
+    return result;
+}
+
+/**
+ * @brief Logical shift left operator for an expiring vec4state.
+ * 
+ * Shifts this vector to the left by the number of bit positions given by other vector (as in operator<<), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator<<=) and moved into the result, so no memory is allocated.
+ * 
+ * @param other The vector that holds the number of bit positions to shift by.
+ * @return A vector that holds the result of the logical shift left operation. If other vector holds unknown bits, then the result is only x's.
+ */
+vec4state vec4state::operator<<(const vec4state& other) && {
+    return move(*this <<= other);
+}
+
+/**
+ * @brief Logical shift left operator for vec4state.
+ * 
+ * Shifts this vector to the left by the number of bit positions given by num. The vacated bit positions are filled with zeros.
+ * 
+ * @param num The number of bit positions to shift by.
+ * @return A new vector that holds the result of the logical shift left operation.
+ */
+vec4state vec4state::operator<<(const long long num) const& {
+    vec4state result;
+    v4::shl(result, *this, num);
+    return result;
+}
+
+/**
+ * @brief Logical shift left operator for an expiring vec4state.
+ * 
+ * Shifts this vector to the left by num bit positions (as in operator<<), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator<<=) and moved into the result, so no memory is allocated.
+ * 
+ * @param num The number of bit positions to shift by.
+ * @return A vector that holds the result of the logical shift left operation.
+ */
+vec4state vec4state::operator<<(const long long num) && {
+    return move(*this <<= num);
+}
+
+/**
+ * @brief Logical shift right operator for vec4state.
+ * 
+ * Converts other vector to a long long number, then shifts this vector to the right by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, the result is a vector of 0's.
+ * 
+ * @param other The vector that holds the number of bit positions to shift by.
+ * @return A new vector that holds the result of the logical shift right operation. If other vector holds unknown bits, then the result is only x's.
+ */
+vec4state vec4state::operator>>(const vec4state& other) const& {
+    uint64_t num = 0;
+    NumberStatus status = other.tryToUint64(num);
+    if (status == NUMBER_UNKNOWN) {
+        return vec4state(X, numBits);
+    }
+    if (status == NUMBER_TOO_LARGE) {
+        return vec4state(ZERO, numBits);
+    }
+    vec4state result = *this >> (long long)(num);
+    return result;
+}
+
+/**
+ * @brief Logical shift right operator for an expiring vec4state.
+ * 
+ * Shifts this vector to the right by the number of bit positions given by other vector (as in operator>>), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator>>=) and moved into the result, so no memory is allocated.
+ * 
+ * @param other The vector that holds the number of bit positions to shift by.
+ * @return A vector that holds the result of the logical shift right operation. If other vector holds unknown bits, then the result is only x's.
+ */
+vec4state vec4state::operator>>(const vec4state& other) && {
+    return move(*this >>= other);
+}
+
+/**
+ * @brief Logical shift left operator for vec4state.
+ * 
+ * Shifts this vector to the right by the number of bit positions given by num. The vacated bit positions are filled with zeros.
+ * 
+ * @param num The number of bit positions to shift by.
+ * @return A new vector that holds the result of the logical shift right operation.
  */
-vec4state vec4state::operator|(const vec4state& other) const {
-    vec4state copyThis = *this;
-    vec4state copyOther = other;
-    long long maxVectorSize = max(vectorSize, other.vectorSize);
-    long long maxNumBits = max(numBits, other.numBits);
-    vec4state result = vec4state(ZERO, maxNumBits);
-    copyThis.setNumBits(maxNumBits);
-    copyOther.setNumBits(maxNumBits);
-    for (long long i = 0; i < maxVectorSize; i++) {
-        // If the vectors hold z's, change the z's to x's.
-        if (i <= vectorSize - 1) {
-            VPI currThisVPI = copyThis.vector[i];
-            copyThis.vector[i].setAval(currThisVPI.getKnownBits());
-        }
-        if (i <= other.vectorSize - 1) {
-            VPI currOtherVPI = copyOther.vector[i];
-            copyOther.vector[i].setAval(currOtherVPI.getKnownBits());
-        }
-    }
-    for (long long i = 0; i < maxVectorSize; i++) {
-        // If one of the vectors holds 1 in the same indices as the other vector holds x, remove the x.
-        if (i <= vectorSize - 1 && i <= other.vectorSize - 1) {
-            VPI currThisVPI = copyThis.vector[i];
-            VPI currOtherVPI = copyOther.vector[i];
-            copyThis.vector[i].setBval(currThisVPI.getBval() - (currOtherVPI.getAval() & currThisVPI.getBval()));
-            copyOther.vector[i].setBval(currOtherVPI.getBval() - (currThisVPI.getAval() & currOtherVPI.getBval()));
-        } else {
-            break;
-        }
-    }
-    for (long long i = 0; i < maxVectorSize; i++) {
-        // Calculate the bitwise OR of the vectors by bitwise OR of the aval and bval of each VPI.
-        if (i <= vectorSize - 1 && i <= other.vectorSize - 1) {
-            VPI currThisVPI = copyThis.vector[i];
-            VPI currOtherVPI = copyOther.vector[i];
-            result.vector[i].setAval(currThisVPI.getAval() | currOtherVPI.getAval());
-            result.vector[i].setBval(currThisVPI.getBval() | currOtherVPI.getBval());
-        } else if (i <= vectorSize - 1) {
-            result.vector[i] = copyThis.vector[i];
-        } else {
-            result.vector[i] = copyOther.vector[i];
-        }
-        // If the result vector holds unknown bits, update unkonwn field.
-        if (result.vector[i].getBval() != 0) {
-            result.unknown = true;
-        }
-    }
-    return move(result);
+vec4state vec4state::operator>>(const long long num) const& {
+    vec4state result;
+    v4::shr(result, *this, num);
+    return result;
 }
 
 /**
- * @brief Bitwise XOR operator for vec4state.
+ * @brief Logical shift right operator for an expiring vec4state.
  * 
- * Calculates the bitwise XOR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise AND between each vector and the bitwise NOT of the other vector, then calculates the bitwise OR of the two results.
+ * Shifts this vector to the right by num bit positions (as in operator>>), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator>>=) and moved into the result, so no memory is allocated.
  * 
- * @param other The vector to perform the bitwise XOR operation with.
- * @return A new vector that holds the result of the bitwise XOR operation.
+ * @param num The number of bit positions to shift by.
+ * @return A vector that holds the result of the logical shift right operation.
  */
-vec4state vec4state::operator^(const vec4state& other) const {
-    vec4state result = vec4state(ZERO, max(numBits, other.numBits));
-    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
-    if (numBits < other.numBits) {
-        vec4state copyThis = *this;
-        copyThis.setNumBits(other.numBits);
-        result = (copyThis & ~other) | (~copyThis & other);
-    } else if (numBits > other.numBits) {
-        vec4state copyOther = other;
-        copyOther.setNumBits(numBits);
-        result = (*this & ~copyOther) | (~(*this) & copyOther);
-    } else {
-        result = (*this & ~other) | (~(*this) & other);
-    }
-    return move(result);
+vec4state vec4state::operator>>(const long long num) && {
+    return move(*this >>= num);
 }
 
 /**
- * @brief Helper function for zeroing down the bits that are out of range.
+ * @brief Bitwise AND assignment operator for vec4state.
  * 
- * Zeroes down the bits that are out of range while vector stays the same size. The function iterates over vector's VPIs starting from the last relevant cell up to vectorSize, and zeroes down the bits that are out of numBits range.
+ * Calculates the bitwise AND of this vector and other vector (as in operator&) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
  * 
- * @param vector The vector to zero down the bits in.
- * @param vectorSize The size of the vector.
- * @param numBits The number of bits in the vector that are in range.
+ * @param other The vector to perform the bitwise AND operation with.
+ * @return A reference to this vector.
  */
-void zeroDownOutOfRangeBits(shared_ptr<VPI[]> vector, long long vectorSize, long long numBits) {
-    // Find the index of the last relevant VPI.
-    long long indexLastCell = calcVectorSize(numBits) - 1;
-    // Find the offset of the last relevant bit in the last relevant VPI.
-    long long offset = numBits % BITS_IN_VPI;
-    long long mask = MASK_32 >> (BITS_IN_VPI - offset);
-    // Zero down the bits that are out of range.
-    for (long long i = indexLastCell; i < vectorSize; i++) {
-        // If the current cell is the last relevant cell.
-        if (i == indexLastCell) {
-            // If the last relevant cell needs to be truncated in the middle.
-            if (offset) {
-                VPI currVPI = vector[i];
-                vector[i].setAval(currVPI.getAval() & mask);
-                vector[i].setBval(currVPI.getBval() & mask);
-            }
-        }
-        // If all of the bits in the current cell are out of range.
-        else {
-            vector[i].setAval(0);
-            vector[i].setBval(0);
-        }
-    }
+vec4state& vec4state::operator&=(const vec4state& other) {
+    makeUnique();
+    long long sharedLimbs = min(numLimbs, other.numLimbs);
+    const limb_t* otherAval = other.aval;
+    const limb_t* otherBval = other.bval;
+    limb_t unknownBits = 0;
+    for (long long i = 0; i < sharedLimbs; i++) {
+        limb_t oneBits = (aval[i] & ~bval[i]) & (otherAval[i] & ~otherBval[i]);
+        limb_t currBval = (aval[i] | bval[i]) & (otherAval[i] | otherBval[i]) & ~oneBits;
+        aval[i] = oneBits;
+        bval[i] = currBval;
+        unknownBits |= currBval;
+    }
+    // Other vector is zero-extended, so the rest of this vector is 0's.
+    for (long long i = sharedLimbs; i < numLimbs; i++) {
+        aval[i] = 0;
+        bval[i] = 0;
+    }
+    unknown = unknownBits != 0;
+    return *this;
 }
 
 /**
- * @brief Bitwise NOT operator for vec4state.
+ * @brief Bitwise OR assignment operator for vec4state.
  * 
- * Calculates the bitwise NOT of each bit in the vector, resulting in one bit for each bit of the vector. If the bit is 0, the result bit is 1. If the bit is 1, the result bit is 0. If the bit is unknown, the result bit is x. The method iterates over the vector's VPIs, and sets each bit in the aval to 1 only if the corresponding bit in the original vector is 0 (in any other case, the bit is set to 0, which means it can be either 0 or x). The bval stays the same (which means every known bit stays known and every unknown bit can be only x). Then the method zeroes down the bits that are out of range (because they have been set to 1 in the bitwise NOT).
+ * Calculates the bitwise OR of this vector and other vector (as in operator|) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
  * 
- * @return A new vector that holds the result of the bitwise NOT operation.
+ * @param other The vector to perform the bitwise OR operation with.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator~() const {
-    vec4state result = *this;
-    for (int i = 0; i < vectorSize; i++) {
-        VPI currVPI = result.vector[i];
-        result.vector[i].setAval(~(currVPI.getAval() | currVPI.getBval()));
-    }
-    zeroDownOutOfRangeBits(result.vector, result.vectorSize, result.numBits);
-    return move(result);
+vec4state& vec4state::operator|=(const vec4state& other) {
+    makeUnique();
+    long long sharedLimbs = min(numLimbs, other.numLimbs);
+    const limb_t* otherAval = other.aval;
+    const limb_t* otherBval = other.bval;
+    for (long long i = 0; i < sharedLimbs; i++) {
+        limb_t oneBits = (aval[i] & ~bval[i]) | (otherAval[i] & ~otherBval[i]);
+        bval[i] = (bval[i] | otherBval[i]) & ~oneBits;
+        aval[i] = oneBits;
+    }
+    // Other vector is zero-extended, so the rest of this vector is ORed with 0's (which turns z's into x's).
+    for (long long i = sharedLimbs; i < numLimbs; i++) {
+        aval[i] &= ~bval[i];
+    }
+    // The bits of other vector that are out of range of this vector are ignored.
+    zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    setUnknown();
+    return *this;
 }
 
 /**
- * @brief Logical equality operator for vec4state.
+ * @brief Bitwise XOR assignment operator for vec4state.
  * 
- * Compares this vector to other vector bit for bit. This is done by calculating the bitwise XOR of the two vectors, and then checking if the result vector is zero. If the result vector holds at least one 1 bit, the vectors are not equal. If the result vector has unknown bits, the comparison is ambiguous and the method returns x. In any other case, if the result vector is only 0's, the vectors are equal. 
+ * Calculates the bitwise XOR of this vector and other vector (as in operator^) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
  * 
- * @param other The vector to compare to.
- * @return 1'b0 if the comparison fails.
- * @return 1'b1 if the comparison succeeds.
- * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+ * @param other The vector to perform the bitwise XOR operation with.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator==(const vec4state& other) const {
-    vec4state xorVector = *this ^ other;
-    // Checks if the result vector has 1 bits, which means the vectors are not equal.
-    for (long long i = 0; i < xorVector.vectorSize; i++) {
-        if (xorVector.vector[i].getAval() != 0) {
-            return vec4state(ZERO, 1);
-        }
-    }
-    // Checks if the result vector has unknown bits, which means the comparison is ambiguous.
-    for (long long i = 0; i < xorVector.vectorSize; i++) {
-        if (xorVector.vector[i].getBval() != 0) {
-            return vec4state(X, 1);
-        }
-    }
-    return vec4state(ONE, 1);
+vec4state& vec4state::operator^=(const vec4state& other) {
+    makeUnique();
+    long long sharedLimbs = min(numLimbs, other.numLimbs);
+    const limb_t* otherAval = other.aval;
+    const limb_t* otherBval = other.bval;
+    for (long long i = 0; i < sharedLimbs; i++) {
+        limb_t currBval = bval[i] | otherBval[i];
+        aval[i] = (aval[i] ^ otherAval[i]) & ~currBval;
+        bval[i] = currBval;
+    }
+    // Other vector is zero-extended, so the rest of this vector is XORed with 0's (which turns z's into x's).
+    for (long long i = sharedLimbs; i < numLimbs; i++) {
+        aval[i] &= ~bval[i];
+    }
+    // The bits of other vector that are out of range of this vector are ignored.
+    zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    setUnknown();
+    return *this;
 }
 
 /**
- * @brief Logical inequality operator for vec4state.
+ * @brief Adds a vector to this vector in place.
  * 
- * Compares this vector to other vector bit for bit. This is done by checking if the vectors are equal using the logical equality operator, and then negating the result.
+ * Adds other vector to the limbs of this vector in a single carry chain (using addLimbs), where a limb that is out of range of other vector is 0 and the carry propagation stops once the carry is 0. The result keeps the number of bits of this vector. Both vectors must hold only known bits.
  * 
- * @param other The vector to compare to.
- * @return 1'b1 if the comparison fails.
- * @return 1'b0 if the comparison succeeds.
- * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+ * @param other The vector to add.
+ * @return true if the sum has a carry out of the most significant bit of this vector.
+ * @return false otherwise.
  */
-vec4state vec4state::operator!=(const vec4state& other) const {
-    return !(*this == other);
+bool vec4state::addInPlace(const vec4state& other) {
+    makeUnique();
+    limb_t carry = addLimbs(aval, bval, aval, numLimbs, other.aval, other.numLimbs, numLimbs);
+    // Find the carry out of the most significant bit, which is either in the last limb or out of it.
+    long long offset = numBits % BITS_IN_LIMB;
+    if (offset != 0) {
+        carry = (aval[numLimbs - 1] >> offset) & 1;
+        aval[numLimbs - 1] &= MASK_LIMB >> (BITS_IN_LIMB - offset);
+    }
+    return carry != 0;
 }
 
 /**
- * @brief Case equality operator for vec4state.
+ * @brief Addition assignment operator for vec4state.
  * 
- * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' VPIs, and checks if the aval and bval of each VPI are equal. If at least one of the VPIs is not equal, the vectors are not equal. If all of the VPIs are equal, the vectors are equal.
+ * Calculates the sum of this vector and other vector (as in operator+) and stores the result in this vector. The result keeps the number of bits of this vector, so the carry out of the most significant bit is discarded. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
  * 
- * @param other The vector to compare to.
- * @return 1'b0 if the comparison fails.
- * @return 1'b1 if the comparison succeeds.
+ * @param other The vector to add.
+ * @return A reference to this vector.
  */
-vec4state vec4state::caseEquality(const vec4state& other) const {
-    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
-    if (numBits < other.numBits) {
-        vec4state copyThis = *this;
-        copyThis.setNumBits(other.numBits);
-        return copyThis.caseEquality(other);
-    } else if (numBits > other.numBits) {
-        vec4state copyOther = other;
-        copyOther.setNumBits(numBits);
-        return this->caseEquality(copyOther);
-    }
-    // Iterate over the vectors' VPIs and check if the aval and bval of each VPI are equal.
-    else {
-        for (int i = 0; i < vectorSize; i++) {
-        VPI currThisVPI = vector[i];
-        VPI currOtherVPI = other.vector[i];
-        if (currThisVPI.getAval() != currOtherVPI.getAval() || currThisVPI.getBval() != currOtherVPI.getBval()) {
-            return vec4state(ZERO, 1);
-        }
-    }
-    return vec4state(ONE, 1);
+vec4state& vec4state::operator+=(const vec4state& other) {
+    if (unknown || other.unknown) {
+        fill(X);
+        return *this;
     }
+    addInPlace(other);
+    return *this;
 }
 
 /**
- * @brief Case inequality operator for vec4state.
+ * @brief Subtraction assignment operator for vec4state.
  * 
- * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall not match for the result to be considered unequal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method calculates the case equality of the vectors and then negates the result.
+ * Calculates the difference between this vector and other vector (as in operator-) and stores the result in this vector. The result keeps the number of bits of this vector, and a negative result is represented in two's complement. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
  * 
- * @param other The vector to compare to.
- * @return 1'b1 if the comparison fails.
- * @return 1'b0 if the comparison succeeds.
+ * @param other The vector to subtract.
+ * @return A reference to this vector.
  */
-vec4state vec4state::caseInequality(const vec4state& other) const {
-    return !caseEquality(other);
+vec4state& vec4state::operator-=(const vec4state& other) {
+    if (unknown || other.unknown) {
+        fill(X);
+        return *this;
+    }
+    makeUnique();
+    subLimbs(aval, bval, aval, numLimbs, other.aval, other.numLimbs, numLimbs);
+    // A negative result borrows beyond the most significant bit, so the bits that are out of range are zeroed down.
+    zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    return *this;
 }
 
 /**
- * @brief Logical shift left operator for vec4state.
+ * @brief Logical shift left assignment operator for vec4state.
  * 
- * Extracts the value stored in other vector, then shifts this vector to the left by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, the result is a vector of 0's.
+ * Extracts the value stored in other vector, then shifts this vector in place to the left by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, this vector is set to 0's. If other vector holds unknown bits, this vector is set to x's.
  * 
  * @param other The vector that holds the number of bit positions to shift by.
- * @return A new vector that holds the result of the logical shift left operation. If other vector holds unknown bits, then the result is only x's.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator<<(const vec4state& other) {
-    long long numOfThis;
-    try {
-        numOfThis = other.extractNumberFromVector();
-    } catch (vec4stateExceptionUnknownVector&) {
-        return vec4state(X, numBits);
-    } catch (vec4stateExceptionInvalidSize&) {
-        return vec4state(ZERO, numBits);
+vec4state& vec4state::operator<<=(const vec4state& other) {
+    uint64_t num = 0;
+    NumberStatus status = other.tryToUint64(num);
+    if (status == NUMBER_UNKNOWN) {
+        fill(X);
+        return *this;
     }
-    vec4state result = *this << numOfThis;
-    return move(result);
+    if (status == NUMBER_TOO_LARGE) {
+        fill(ZERO);
+        return *this;
+    }
+    return *this <<= (long long)(num);
 }
 
 /**
- * @brief Logical shift left operator for vec4state.
+ * @brief Logical shift left assignment operator for vec4state.
  * 
- * Shifts this vector to the left by the number of bit positions given by num. The vacated bit positions are filled with zeros.
+ * Shifts this vector in place to the left by the number of bit positions given by num (using shiftLimbsLeft). The limbs are moved from the most significant limb down, so no temporary vector is needed. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in the vector, this vector is set to 0's.
  * 
  * @param num The number of bit positions to shift by.
- * @return A new vector that holds the result of the logical shift left operation.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator<<(const long long num) {
-    // If the number of bit positions to shift by is 0, the result is the same vector.
+vec4state& vec4state::operator<<=(const long long num) {
+    // If the number of bit positions to shift by is 0, the vector stays the same.
     if (num == 0) {
         return *this;
     }
-    // If the number of bit positions to shift by is negative, the result is a vector of 0's.
-    if (num < 0) {
-        return vec4state(ZERO, numBits);
-    }
-    // If the number of bit positions to shift by is greater than the number of bits in the vector, the result is a vector of 0's.
-    if (num >= numBits) {
-        return vec4state(ZERO, numBits);
-    }
-    vec4state res = *this;
-    long long offset = num / BITS_IN_VPI;
-    // Shifting whole cells
-    if (offset > 0) {
-        // If the number of bit positions to shift by is greater than the number of bits in a VPI, shift the whole cells.
-        // The cells are shifted to the left by num/BITS_IN_VPI cells.
-        for (long long i = vectorSize - offset - 1; i >= 0; i--) {
-            VPI currThisVPI = vector[i];
-            (res.vector[i + offset]).setAval(currThisVPI.getAval());
-            (res.vector[i + offset]).setBval(currThisVPI.getBval());
-            if (res.vector[i + offset].getBval() != 0) {
-                res.unknown = true;
-            }
-            res.vector[i].setAval(0);
-            res.vector[i].setBval(0);
-        }
+    // If the number of bit positions to shift by is negative or greater than the number of bits in the vector, the result is a vector of 0's.
+    if (num < 0 || num >= numBits) {
+        fill(ZERO);
+        return *this;
     }
-    // Shifting the remaining bits
-    for (long long i = vectorSize - 1; i >= 0; i--) {
-        // If the number of bit positions to shift by is not a multiple of the number of bits in a VPI, shift the remaining bits.
-        // The bits are shifted to the left by num%BITS_IN_VPI bits.
-        // The bits that are shifted out of the VPI are stored in the next VPI. 
-        VPI currVPI = res.vector[i];
-        res.vector[i].setAval(currVPI.getAval() << (num % BITS_IN_VPI));
-        res.vector[i].setBval(currVPI.getBval() << (num % BITS_IN_VPI));
-        currVPI = res.vector[i];
-        if (i > 0) {
-            // If the current VPI is not the first VPI, store the bits that are shifted out of the previous VPI in the current VPI.
-            VPI prevVPI = res.vector[i - 1];
-            res.vector[i].setAval(currVPI.getAval() | (prevVPI.getAval() >> (BITS_IN_VPI - (num % BITS_IN_VPI))));
-            res.vector[i].setBval(currVPI.getBval() | (prevVPI.getBval() >> (BITS_IN_VPI - (num % BITS_IN_VPI))));
-        }
-        if (res.vector[i].getBval() != 0) {
-            res.unknown = true;
-        }
+    makeUnique();
+    shiftLimbsLeft(aval, bval, aval, bval, numLimbs, num);
+    // The bits that are shifted beyond the last bit are out of range.
+    zeroDownOutOfRangeBits(aval, bval, numLimbs, numBits);
+    if (unknown) {
+        setUnknown();
     }
-    return move(res);
+    return *this;
 }
 
 /**
- * @brief Logical shift right operator for vec4state.
+ * @brief Logical shift right assignment operator for vec4state.
  * 
- * Converts other vector to a long long number, then shifts this vector to the right by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, the result is a vector of 0's.
+ * Extracts the value stored in other vector, then shifts this vector in place to the right by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, this vector is set to 0's. If other vector holds unknown bits, this vector is set to x's.
  * 
  * @param other The vector that holds the number of bit positions to shift by.
- * @return A new vector that holds the result of the logical shift right operation. If other vector holds unknown bits, then the result is only x's.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator>>(const vec4state& other) {
-    long long numOfThis;
-    try {
-        numOfThis = other.extractNumberFromVector();
-    } catch (vec4stateExceptionUnknownVector&) {
-        return vec4state(X, numBits);
-    } catch (vec4stateExceptionInvalidSize&) {
-        return vec4state(ZERO, numBits);
+vec4state& vec4state::operator>>=(const vec4state& other) {
+    uint64_t num = 0;
+    NumberStatus status = other.tryToUint64(num);
+    if (status == NUMBER_UNKNOWN) {
+        fill(X);
+        return *this;
     }
-    vec4state result = *this >> numOfThis;
-    return move(result);
+    if (status == NUMBER_TOO_LARGE) {
+        fill(ZERO);
+        return *this;
+    }
+    return *this >>= (long long)(num);
 }
 
 /**
- * @brief Logical shift left operator for vec4state.
+ * @brief Logical shift right assignment operator for vec4state.
  * 
- * Shifts this vector to the right by the number of bit positions given by num. The vacated bit positions are filled with zeros.
+ * Shifts this vector in place to the right by the number of bit positions given by num (using shiftLimbsRight). The limbs are moved from the least significant limb up, so no temporary vector is needed. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in the vector, this vector is set to 0's.
  * 
  * @param num The number of bit positions to shift by.
- * @return A new vector that holds the result of the logical shift right operation.
+ * @return A reference to this vector.
  */
-vec4state vec4state::operator>>(const long long num) {
-    // If the number of bit positions to shift by is 0, the result is the same vector.
+vec4state& vec4state::operator>>=(const long long num) {
+    // If the number of bit positions to shift by is 0, the vector stays the same.
     if (num == 0) {
         return *this;
     }
-    // If the number of bit positions to shift by is negative, the result is a vector of 0's with the same number of bits as this vector.
-    if (num < 0) {
-        return vec4state(ZERO, numBits);
-    }
-    // If the number of bit positions to shift by is greater than the number of bits in the vector, the result is a vector of 0's with the same number of bits as this vector.
-    if (num >= numBits) {
-        return vec4state(ZERO, numBits);
-    }
-    vec4state res = *this;
-    long long offset = num / BITS_IN_VPI;
-    // Shifting whole cells
-    if (offset > 0) {
-        // If the number of bit positions to shift by is greater than the number of bits in a VPI, shift the whole cells.
-        for (long long i = offset; i < vectorSize; i++) {
-            // The cells are shifted to the right by num/BITS_IN_VPI cells.
-            VPI currThisVPI = vector[i];
-            res.vector[i - offset].setAval(currThisVPI.getAval());
-            res.vector[i - offset].setBval(currThisVPI.getBval());
-            if (res.vector[i - offset].getBval() != 0) {
-                res.unknown = true;
-            }
-            res.vector[i].setAval(0);
-            res.vector[i].setBval(0);
-        }
+    // If the number of bit positions to shift by is negative or greater than the number of bits in the vector, the result is a vector of 0's.
+    if (num < 0 || num >= numBits) {
+        fill(ZERO);
+        return *this;
     }
-    // Shifting the remaining bits
-    for (int i = 0; i < vectorSize; i++) {
-        // If the number of bit positions to shift by is not a multiple of the number of bits in a VPI, shift the remaining bits.
-        // The bits are shifted to the right by num%BITS_IN_VPI bits.
-        // The bits that are shifted out of the VPI are stored in the previous VPI.
-        VPI currVPI = res.vector[i];
-        res.vector[i].setAval(currVPI.getAval() >> (num % BITS_IN_VPI));
-        res.vector[i].setBval(currVPI.getBval() >> (num % BITS_IN_VPI));
-        currVPI = res.vector[i];
-        if (i < vectorSize - 1) {
-            // If the current VPI is not the last VPI, store the bits that are shifted out of the next VPI in the current VPI.
-            VPI nextVPI = res.vector[i + 1];
-            res.vector[i].setAval(currVPI.getAval() | (nextVPI.getAval() << (BITS_IN_VPI - (num % BITS_IN_VPI))));
-            res.vector[i].setBval(currVPI.getBval() | (nextVPI.getBval() << (BITS_IN_VPI - (num % BITS_IN_VPI))));
-        }
-        if (res.vector[i].getBval() != 0) {
-            res.unknown = true;
-        }
+    makeUnique();
+    shiftLimbsRight(aval, bval, aval, bval, numLimbs, num);
+    if (unknown) {
+        setUnknown();
     }
-    return move(res);
+    return *this;
 }
 
 /**
  * @brief Get bit select operator for vec4state.
  * 
- * Extracts the bit stored in this vector at the given index by extracting the value stored in index and by using the getPartSelect method by setting the start and end indices to index.
+ * Extracts the bit stored in this vector at the given index by decoding index with tryToUint64 and by reading the bit with getBit.
  * 
  * @param index The index of the bit to extract.
  * @return The value of the bit at index index in this vector. If the index holds unknown values or is out of range, the result is a vector of x's.
  */
 vec4state vec4state::getBitSelect(const vec4state& index) const {
-    long long bitIndex;
-    vec4state result = vec4state(ZERO, numBits);
-    try {
-        bitIndex = index.extractNumberFromVector();
-    } catch (vec4stateExceptionUnknownVector&) {
-        // If the index is unknown, the result is unknown.
-        result.setBitSelect(0, X);
-        return move(result);
-    } catch (vec4stateExceptionInvalidSize&) {
-        // If the index is out of range, the result is unknown.
-        result.setBitSelect(0, X);
-        return move(result);
-        return vec4state(X, 1);
-    }
-    if (bitIndex > numBits) {
-        // If the index is out of range, the result is unknown.
-        result.setBitSelect(0, X);
-        return move(result);
-    }
-    return getPartSelect(bitIndex, bitIndex);
+    uint64_t num = 0;
+    bool validIndex = index.tryToUint64(num) == NUMBER_OK;
+    long long bitIndex = (long long)(num);
+    if (!validIndex || bitIndex > numBits) {
+        // If the index is unknown or out of range, the result is unknown.
+        vec4state result = vec4state(ZERO, numBits);
+        result.setBit(0, X);
+        return result;
+    }
+    return vec4state(getBit(bitIndex).toBitValue(), 1);
 }
 
 /**
@@ -853,16 +2383,12 @@ vec4state vec4state::getBitSelect(const vec4state& index) const {
  * @param newValue The value to set the bit to. If the index holds unknown values or is out of range, this vector remains unchanged.
  */
 void vec4state::setBitSelect(const vec4state& index, const vec4state& newValue) {
-    long long bitIndex;
-    try {
-        bitIndex = index.extractNumberFromVector();
-    } catch (vec4stateExceptionUnknownVector&) {
-        // If the index is unknown, do nothing.
-        return;
-    } catch (vec4stateExceptionInvalidSize&) {
-        // If the index is out of range, do nothing.
+    uint64_t num = 0;
+    // If the index is unknown or too large, do nothing.
+    if (index.tryToUint64(num) != NUMBER_OK) {
         return;
     }
+    long long bitIndex = (long long)(num);
     if (bitIndex > numBits) {
         // If the index is out of range, do nothing.
         return;
@@ -871,44 +2397,56 @@ void vec4state::setBitSelect(const vec4state& index, const vec4state& newValue)
 }
 
 /**
- * @brief Bitwise AND of the aval and bval of the vectors.
+ * @brief Reads a single bit of the vector.
  * 
- * Calculates the bitwise AND of the aval and bval of the vectors. The method iterates over the vectors' VPIs and calculates the bitwise AND of the aval and bval of each VPI. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector.
+ * Loads the limb of each plane that holds the bit and masks the bit out of it, so reading a bit takes constant time and doesn't allocate memory (unlike getBitSelect, which decodes an index vector and returns a vector).
  * 
- * @param other The vector to perform the bitwise AND operation with.
- * @return A new vector that holds the result of the bitwise AND operation.
+ * @param index The index of the bit to read.
+ * @return The value of the bit at index index, or x if the index is out of range.
  */
-vec4state vec4state::bitwiseAndAvalBval(const vec4state& other) const {
-    long long maxSize = max(numBits, other.numBits);
-    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
-    if (numBits < other.numBits) {
-        vec4state copyThis = *this;
-        copyThis.setNumBits(other.numBits);
-        return copyThis.bitwiseAndAvalBval(other);
-    } else if (numBits > other.numBits) {
-        vec4state copyOther = other;
-        copyOther.setNumBits(numBits);
-        return bitwiseAndAvalBval(copyOther);
-    } else {
-        vec4state result = vec4state(ZERO, maxSize);
-        // Iterate over the vectors' VPIs and calculate the bitwise AND of the aval and bval of each VPI.
-        for (int i = 0; i < result.vectorSize; i++) {
-            VPI currThisVPI = vector[i];
-            VPI currOtherVPI = other.vector[i];
-            result.vector[i].setAval(currThisVPI.getAval() & currOtherVPI.getAval());
-            result.vector[i].setBval(currThisVPI.getBval() & currOtherVPI.getBval());
-            if (result.vector[i].getBval() != 0) {
-                result.unknown = true;
-            }
-        }
-        return move(result);
+logic vec4state::getBit(long long index) const {
+    if (index < 0 || index >= numBits) {
+        return logic(X);
+    }
+    long long limbIndex = index / BITS_IN_LIMB;
+    long long offset = index % BITS_IN_LIMB;
+    return logic((aval[limbIndex] >> offset) & 1, (bval[limbIndex] >> offset) & 1);
+}
+
+/**
+ * @brief Writes a single bit of the vector.
+ * 
+ * Stores the bit into the limb of each plane that holds it with a mask, so writing a bit takes constant time and doesn't allocate memory, unless the planes are shared with another vector. The unknown flag is updated from the bit, and the vector is scanned for unknown bits only when an x or z bit is overwritten with a 0 or a 1. If the index is out of range, the vector remains unchanged. If bit is not a BitValue, vec4stateExceptionInvalidInput is thrown.
+ * 
+ * @param index The index of the bit to write.
+ * @param bit The value to write.
+ */
+void vec4state::setBit(long long index, BitValue bit) {
+    if (bit != ZERO && bit != ONE && bit != X && bit != Z) {
+        throw vec4stateExceptionInvalidInput("Invalid bit");
+    }
+    if (index < 0 || index >= numBits) {
+        return;
+    }
+    logic newBit(bit);
+    long long limbIndex = index / BITS_IN_LIMB;
+    limb_t mask = limb_t(1) << (index % BITS_IN_LIMB);
+    makeUnique();
+    bool wasUnknown = (bval[limbIndex] & mask) != 0;
+    aval[limbIndex] = newBit.getAval() ? (aval[limbIndex] | mask) : (aval[limbIndex] & ~mask);
+    bval[limbIndex] = newBit.getBval() ? (bval[limbIndex] | mask) : (bval[limbIndex] & ~mask);
+    if (newBit.isUnknown()) {
+        unknown = true;
+    } else if (wasUnknown) {
+        // The overwritten bit might have been the only unknown bit of the vector.
+        setUnknown();
     }
 }
 
 /**
  * @brief Get part select operator for vec4state.
  * 
- * Extracts the part of this vector from index start to index end. If the start index is greater than the end index, vec4stateExceptionInvalidRange is thrown. If the slice is out of range, the out of range bits are set to x. This is done by shifting this vector's bit until reaching the desired bits, then extracting the relevant bits from the vector. If the part is out of range, the out of range bits are set to x.
+ * Extracts the part of this vector from index start to index end. If the start index is greater than the end index, vec4stateExceptionInvalidRange is thrown. If the slice is out of range, the out of range bits are set to x. Each limb of the result is funnel-shifted out of the (at most two) limbs of this vector that hold its bits, so only the limbs of the slice are read and the cost is proportional to the width of the slice, not to the size of this vector.
  * 
  * @param end The end index of the part to extract.
  * @param start The start index of the part to extract.
@@ -923,142 +2461,72 @@ vec4state vec4state::getPartSelect(long long end, long long start) const {
     if (end < 0 || start >= numBits) {
         return vec4state(X, end - start + 1);
     }
-    vec4state result = vec4state(Z, end - start + 1);
-    vec4state wanted = *this;
-    // Move the bits to the right if the slice starts after index 0.
-    if (start >= 0) {
-        wanted = wanted >> start;
-    }
-    wanted = wanted.getPartValidRange(min(end + 1, numBits));
-    
-    // Extract the relevant bits from the vector.
-    result = result.bitwiseAndAvalBval(wanted);
-    result.decNumBits(end - start + 1);
-    // If the slice ends after the last index, put x's where the index is greater than the number of bits.
-    if (end >= numBits) {
-        result.setPartSelect(result.numBits - 1, numBits, vec4state(X, result.numBits - numBits)); 
-    }
-    // If the slice starts before the first index, put x's where the index is less than 0.
-    if (start < 0) {
-        // Move the bits to the left.
-        result = result << (-start);
-        // Put x's where the index is less than 0.
-        result.setPartSelect(-start - 1, 0, vec4state(X, -start));
-    }
-    result.setUnknown();
-    return move(result);
-}
-
-/**
- * @brief Get part of the vector that is in range.
- * 
- * Extracts the part of the vector that is in range, starting from the first bit and ending at the given end index. If the end index is out of range, vec4stateExceptionInvalidInput is thrown. This is done by initializing the result vector to end z bits, which means that it holds end 1 bits in it's aval and bval. Then, the method iterates over the vector's VPIs and copying the relevant bits to the result vector by performing a bitwise AND operation between the vector's VPIs and the result vector's VPIs.
- * 
- * @param end The end index of the part to extract.
- * @return The part of the vector from the first bit to the end index.
- */
-vec4state vec4state::getPartValidRange(long long end) const {
-    if (end < 0) {
-        throw vec4stateExceptionInvalidInput("end must be non-negative");
-    }
-    if (end > numBits) {
-        throw vec4stateExceptionInvalidInput("end must be less than the number of bits in the vector");
-    }
-    // Initialize the result vector to end z bits to be able to perform the bitwise AND operation.
-    vec4state result = vec4state(Z, end);
-    // Iterate over the vector's VPIs and copy the relevant bits to the result vector.
-    for (long long i = 0; i < result.getVectorSize(); i++) {
-        VPI currVecVPI = vector[i];
-        VPI currResultVPI = result.vector[i];
-        // Extract only the bits that are in range.
-        result.vector[i].setAval(currVecVPI.getAval() & currResultVPI.getAval());
-        result.vector[i].setBval(currVecVPI.getBval() & currResultVPI.getBval());
-        if (result.vector[i].getBval() != 0) {
-            result.unknown = true;
+    vec4state result(end - start + 1, NO_INIT);
+    limb_t* resultAval = result.aval;
+    limb_t* resultBval = result.bval;
+    long long resultNumLimbs = result.numLimbs;
+    if (start >= 0 && end < numBits) {
+        // The slice is in range, so every limb of the result is read from this vector.
+        for (long long i = 0; i < resultNumLimbs; i++) {
+            resultAval[i] = readLimbAtBit(aval, numLimbs, start + i * BITS_IN_LIMB);
+            resultBval[i] = readLimbAtBit(bval, numLimbs, start + i * BITS_IN_LIMB);
         }
-    }
-    return move(result);
-}
-
-/**
- * @brief Addition of the aval and bval of the vectors.
- * 
- * Adds the aval and bval of the vectors, resulting in a new vector. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates over the vectors' VPIs and calculates the sum of the aval and bval of each VPI.
- * 
- * @param other The vector to add to this vector.
- * @return A new vector that holds the result of the addition.
- */
-vec4state vec4state::additionAvalBval(const vec4state& other) const {
-    long long maxSize = max(numBits, other.numBits);
-    // If the vectors have different number of bits, change the size of the smaller vector to the size of the larger vector by padding it with 0's.
-    if (numBits < maxSize) {
-        vec4state copyThis = *this;
-        copyThis.incNumBits(maxSize);
-        return copyThis.additionAvalBval(other);
-    } else if (other.numBits < maxSize) {
-        vec4state copyOther = other;
-        copyOther.incNumBits(maxSize);
-        return additionAvalBval(copyOther);
     } else {
-        vec4state result = vec4state(ZERO, maxSize);
-        // Iterate over the vectors' VPIs and calculate the sum of the aval and bval of each VPI.
-        for (long long i = 0; i < result.vectorSize; i++) {
-            VPI currThisVPI = vector[i];
-            VPI currOtherVPI = other.vector[i];
-            result.vector[i].setAval(currThisVPI.getAval() + currOtherVPI.getAval());
-            result.vector[i].setBval(currThisVPI.getBval() + currOtherVPI.getBval());
-            if (result.vector[i].getBval() != 0) {
-                result.unknown = true;
-            }
+        // Put x's in the whole slice, then copy the bits that are in range over them.
+        for (long long i = 0; i < resultNumLimbs; i++) {
+            resultAval[i] = 0;
+            resultBval[i] = MASK_LIMB;
         }
-        return move(result);
+        long long rangeStart = max(start, 0LL);
+        long long rangeEnd = min(end, numBits - 1);
+        copyBits(resultAval, rangeStart - start, aval, numLimbs, rangeStart, rangeEnd - rangeStart + 1);
+        copyBits(resultBval, rangeStart - start, bval, numLimbs, rangeStart, rangeEnd - rangeStart + 1);
     }
+    zeroDownOutOfRangeBits(resultAval, resultBval, resultNumLimbs, result.numBits);
+    result.setUnknown();
+    return result;
 }
 
 /**
  * @brief Set part select operator for vec4state.
  * 
- * Sets the part of the vector starting from the start index and ending at end index, to the value stored in other vector. If the end index is less than the start index, vec4stateExceptionInvalidRange is thrown. This is done by zeroing down the bits between the start and the end indices and inserting the bits of other vector into the slice. If the slice is completely out of range, the vector remains unchanged. If only start or end are out of range, the slice is truncated to the valid range.
+ * Sets the part of the vector starting from the start index and ending at end index, to the value stored in other vector. If the end index is less than the start index, vec4stateExceptionInvalidRange is thrown. Other is truncated or zero-extended to the size of the slice, and its bits are written into the limbs of the slice in place, where only the first and last limbs of the slice keep some of their old bits. If the slice is completely out of range, the vector remains unchanged. If only start or end are out of range, the slice is truncated to the valid range. The cost is proportional to the width of the slice, unless the slice overwrites unknown bits with known bits, which requires checking the rest of the vector for unknown bits.
  * 
  * @param end The end index of the part to set.
  * @param start The start index of the part to set.
  * @param other The vector to set the part to.
  */
-void vec4state::setPartSelect(long long end, long long start, vec4state other) {
+void vec4state::setPartSelect(long long end, long long start, const vec4state& other) {
     // If input is invalid.
     if (end < start) {
         throw vec4stateExceptionInvalidRange(end, start);
     }
-    // If the slice is not completely out of range, perform the operation.
-    if (end >= 0 && start < numBits) {
-        long long oldSize = numBits;
-        
-        // Resizing other to the size of the slice.
-        other.setNumBits(end - start + 1);
-        // In case the slice starts before the first index, move the bits to the right.
-        if (start < 0) {
-            other = other >> (-start);
-        }
-        start = max(start, (long long)(0));
-        end = min(end, numBits - 1);
-        // Adjust the size of other to the size of the slice.
-        other.setNumBits(end - start + 1);
-        // Save the bits before the slice.
-        vec4state beforeStart = vec4state(ZERO, max(start, (long long)(1)));
-        if (start > 0) {
-            beforeStart = getPartValidRange(start);
-        } 
-        // Zero down the bits in the slice.
-        *this = *this >> (end + 1);
-        *this = *this << (end - start + 1);
-        // Insert the bits of other into the slice.
-        *this = additionAvalBval(other);
-        // Move the starting bits back to their original position.
-        *this = *this << start;
-        *this = additionAvalBval(beforeStart);
-        setNumBits(oldSize);
-    }
-    if (other.unknown) {
+    // If the slice is completely out of range, the vector remains unchanged.
+    if (end < 0 || start >= numBits) {
+        return;
+    }
+    // The bits of other are read while the planes of this vector are written, so a vector that is set into itself is copied first.
+    if (&other == this) {
+        vec4state copyOther = other;
+        setPartSelect(end, start, copyOther);
+        return;
+    }
+    long long rangeStart = max(start, 0LL);
+    long long rangeEnd = min(end, numBits - 1);
+    long long count = rangeEnd - rangeStart + 1;
+    // The bit of other that is written into rangeStart, and the number of bits that other has from there (the rest of the slice is 0's).
+    long long otherStart = rangeStart - start;
+    long long otherCount = max(0LL, min(count, other.numBits - otherStart));
+    makeUnique();
+    bool sliceWasUnknown = unknown && hasSetBits(bval, numLimbs, rangeStart, count);
+    copyBits(aval, rangeStart, other.aval, other.numLimbs, otherStart, otherCount);
+    copyBits(bval, rangeStart, other.bval, other.numLimbs, otherStart, otherCount);
+    clearBits(aval, rangeStart + otherCount, count - otherCount);
+    clearBits(bval, rangeStart + otherCount, count - otherCount);
+    if (other.unknown && hasSetBits(bval, numLimbs, rangeStart, otherCount)) {
+        unknown = true;
+    } else if (sliceWasUnknown) {
+        // The unknown bits of the slice might have been the only unknown bits of the vector.
         setUnknown();
     }
 }
@@ -1116,7 +2584,7 @@ vec4state vec4state::operator||(const vec4state& other) const {
 /**
  * @brief Logical NOT operator for vec4state.
  * 
- * Checks if this vector is true (holds at least one 1 bit). This is done by iterating over the vector's VPIs, and checking if at least one of the VPIs has a bit set to 1.
+ * Checks if this vector is true (holds at least one 1 bit). This is done by iterating over the vector's limbs, and checking if at least one of the limbs has a bit set to 1.
  * 
  * @return 1'b0 if the vector is true.
  * @return 1'b1 if the vector is false.
@@ -1124,10 +2592,9 @@ vec4state vec4state::operator||(const vec4state& other) const {
  */
 vec4state vec4state::operator!() const {
     // If the vector has at least one bit set to 1, return 0.
-    for (int i = 0; i < vectorSize; i++) {
-        VPI currVPI = vector[i];
+    for (int i = 0; i < numLimbs; i++) {
         // Extract the 1 bits.
-        uint32_t oneBits = currVPI.getKnownBits();
+        limb_t oneBits = aval[i] & ~bval[i];
         if (oneBits != 0) {
             return vec4state(ZERO, 1);
         }
@@ -1157,29 +2624,29 @@ vec4state vec4state::operator<(const vec4state& other) const {
     }
     // If the vectors are of unequal bit lengths:
     // If this vector is longer than other vector and has at least one bit set to 1 in the extra bits, return 0 (false).
-    if (vectorSize > other.vectorSize) {
-        for (long long i = vectorSize - 1; i >= other.vectorSize; i--) {
-            if (vector[i].getAval() != 0) {
+    if (numLimbs > other.numLimbs) {
+        for (long long i = numLimbs - 1; i >= other.numLimbs; i--) {
+            if (aval[i] != 0) {
                 return vec4state(ZERO, 1);
             }
         }
     // If this vector is shorter than other vector and other vector has at least one bit set to 1 in the extra bits, return 1 (true).
-    } else if (vectorSize < other.vectorSize) {
-        for (long long i = other.vectorSize - 1; i >= vectorSize; i--) {
-            if (other.vector[i].getAval() != 0) {
+    } else if (numLimbs < other.numLimbs) {
+        for (long long i = other.numLimbs - 1; i >= numLimbs; i--) {
+            if (other.aval[i] != 0) {
                 return vec4state(ONE, 1);
             }
         }
     }
-    // Iterate over the vectors' VPIs and check if this vector is less than other vector.
-    for (long long i = min(vectorSize, other.vectorSize) - 1; i >= 0; i--) {
-        VPI currThisVPI = vector[i];
-        VPI currOtherVPI = other.vector[i];
-        // If current VPI of this vector is less than current VPI of other vector, return 1 (true).
-        if (currThisVPI.getAval() < currOtherVPI.getAval()) {
+    // Iterate over the vectors' limbs and check if this vector is less than other vector.
+    for (long long i = min(numLimbs, other.numLimbs) - 1; i >= 0; i--) {
+        limb_t currThisAval = aval[i];
+        limb_t currOtherAval = other.aval[i];
+        // If current limb of this vector is less than current limb of other vector, return 1 (true).
+        if (currThisAval < currOtherAval) {
             return vec4state(ONE, 1);
         }
-        if (currThisVPI.getAval() > currOtherVPI.getAval()) {
+        if (currThisAval > currOtherAval) {
             return vec4state(ZERO, 1);
         }
     }
@@ -1232,236 +2699,142 @@ vec4state vec4state::operator>=(const vec4state& other) const {
 /**
  * @brief Addition operator for vec4state.
  * 
- * Calculates the sum of this vector and other vector. The method iterates over the vectors' VPIs, and calculates the sum of the corresponding VPIs. If the sum is greater than 32 bits, the carry is set to 1 for the next iteration. If there is a carry in the last iteration, the size of the result vector is increased by 1.
+ * Calculates the sum of this vector and other vector. The method iterates over the vectors' limbs, and adds the corresponding limbs together with the carry of the previous limbs (using addWithCarry). If the sum has a carry out of the most significant bit, the size of the result vector is increased by 1.
  * 
  * @param other The vector to add.
  * @return A new vector that holds the result of the addition operation. If one of the vectors holds unknown bits, then the result is only x's.
  */
-vec4state vec4state::operator+(const vec4state& other) const {
-    long long maxNumBits = max(numBits, other.numBits);
+vec4state vec4state::operator+(const vec4state& other) const& {
+    vec4state result;
+    v4::add(result, *this, other);
+    return result;
+}
+
+/**
+ * @brief Addition operator for an expiring vec4state.
+ * 
+ * Calculates the sum of this vector and other vector (as in operator+), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator+=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector. If the sum has a carry out of the most significant bit, the size of the result vector is increased by 1.
+ * 
+ * @param other The vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator+(const vec4state& other) && {
+    // The result is wider than this vector, or has to be built from scratch.
+    if (numBits < other.numBits) {
+        return *this + other;
+    }
     if (unknown || other.unknown) {
-        return vec4state(X, maxNumBits);
-    }
-    vec4state result = vec4state(ZERO, maxNumBits);
-    long long carry = 0;
-    long long sum = 0;
-    // Iterate over the vectors' VPIs and calculate the sum of the corresponding VPIs.
-    for (long long i = 0; i < result.vectorSize; i++) {
-        VPI currThisVPI = this->vector[i];
-        VPI currOtherVPI = other.vector[i];
-        // If the current VPI is out of range of one of the vectors, copy it as is with the carry.
-        if (i >= this->vectorSize) {
-            sum = unsigned long long(currOtherVPI.getAval()) + carry;
-        }
-        else if (i >= other.vectorSize) {
-            sum = unsigned long long(currThisVPI.getAval()) + carry;
-        }
-        // If the current VPI is not out of range of the vectors, calculate the sum with the carry.
-        else {
-            sum = unsigned long long(currThisVPI.getAval()) + unsigned long long(currOtherVPI.getAval()) + carry;
-        }
-        // Put in the result vector only the lower 32 bits of the sum.
-        result.vector[i].setAval(uint32_t(sum & MASK_32));
-        // If the sum is bigger than 32 bits, set the carry to 1 for the next iteration.
-        if (sum > MASK_32) {
-            carry = 1;
-        } else {
-            carry = 0;
-        }
+        fill(X);
+        return move(*this);
     }
-    // If there is a carry in the last iteration, increase the size of the result vector by 1.
-    if (carry) {
-        result.incNumBits(maxNumBits + 1);
-        result.vector[result.vectorSize - 1].setAval(1);
+    // If there is a carry out of the most significant bit, increase the size of the vector by 1.
+    if (addInPlace(other)) {
+        long long carryIndex = numBits;
+        incNumBits(numBits + 1);
+        aval[carryIndex / BITS_IN_LIMB] |= limb_t(1) << (carryIndex % BITS_IN_LIMB);
     }
-    return move(result);
+    return move(*this);
+}
+
+/**
+ * @brief Addition operator for vec4state with an expiring vector.
+ * 
+ * Calculates the sum of this vector and other vector (as in operator+), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator+(vec4state&& other) const& {
+    return move(other) + *this;
+}
+
+/**
+ * @brief Addition operator for two expiring vec4state vectors.
+ * 
+ * Calculates the sum of this vector and other vector (as in operator+), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+ * 
+ * @param other The expiring vector to perform the operation with.
+ * @return A vector that holds the result of the operation.
+ */
+vec4state vec4state::operator+(vec4state&& other) && {
+    if (numBits >= other.numBits) {
+        return move(*this) + other;
+    }
+    return move(other) + *this;
+}
+
+/**
+ * @brief Subtraction operator for vec4state.
+ * 
+ * Calculates the difference between this vector and other vector. The method iterates over the vectors' limbs, and subtracts the corresponding limbs together with the borrow of the previous limbs (using subWithBorrow). If this vector is less than other vector, the result is negative and is represented in two's complement.
+ * 
+ * @param other The vector to subtract.
+ * @return A new vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
+ */
+vec4state vec4state::operator-(const vec4state& other) const& {
+    vec4state result;
+    v4::sub(result, *this, other);
+    return result;
 }
 
 /**
- * @brief Subtraction operator for vec4state.
+ * @brief Subtraction operator for an expiring vec4state.
  * 
- * Calculates the difference between this vector and other vector. The method iterates over the vectors' VPIs, and calculates the difference of the corresponding VPIs. If the current VPI in this vector is less than the corresponding one in other vector, the method borrows from the next positive VPI of this vector. If there is no VPI to borrow from, the result is negative.
+ * Calculates the difference between this vector and other vector (as in operator-), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator-=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
  * 
  * @param other The vector to subtract.
- * @return A new vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
+ * @return A vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
  */
-vec4state vec4state::operator-(const vec4state& other) const {
-    long long maxNumBits = max(numBits, other.numBits);
-    if (unknown || other.unknown) {
-        return vec4state(X, maxNumBits);
-    }
-    vec4state result = vec4state(ZERO, maxNumBits);
-    // Align this to the maximal size.
-    vec4state copyThis = *this;
-    copyThis.setNumBits(maxNumBits);
-    for (long long i = 0; i < result.vectorSize; i++) {
-        // If the current VPI is out of range of the other vector, copy it as is.
-        if (i >= other.vectorSize) {
-            result.vector[i].setAval(copyThis.vector[i].getAval());
-        }
-        // If the current VPI is not out of range of the other vector, calculate the result.
-        else {
-            VPI currThisVPI = copyThis.vector[i];
-            VPI currOtherVPI = other.vector[i];
-            // If the current VPI in this vector is less than the corresponding one in other vector, borrow from the next VPI of this vector.
-            if (currThisVPI.getAval() < currOtherVPI.getAval()) {
-                // Find the first next VPI in this vector that is not zero.
-                long long firstNotZero = i + 1;
-                while (copyThis.vector[firstNotZero].getAval() == 0 && firstNotZero < copyThis.getVectorSize()) {
-                    firstNotZero++;
-                }
-                if (firstNotZero != copyThis.getVectorSize()) {
-                    // If possible, borrow from the next VPI.
-                    copyThis.vector[firstNotZero].setAval(copyThis.vector[firstNotZero].getAval() - 1);
-                    firstNotZero--;
-                    for (; firstNotZero > i; firstNotZero--) {
-                        copyThis.vector[firstNotZero].setAval(MASK_32);
-                    }
-                    // Calculate the fixed value of the current VPI.
-                    result.vector[i].setAval(uint32_t(MASK_BIT_33 + currThisVPI.getAval() - currOtherVPI.getAval()));
-                } else {
-                    // If there is no VPI to borrow from, the result is negative.
-                    for (long long j = 0; j < copyThis.getVectorSize(); j++) {
-                        result.vector[j].setAval(copyThis.vector[j].getAval() - other.vector[j].getAval());
-                    }
-                    return move(result);
-                }
-            }
-            // Calculate the result as usual.
-            else {
-                result.vector[i].setAval(currThisVPI.getAval() - currOtherVPI.getAval());
-            }
-        } 
+vec4state vec4state::operator-(const vec4state& other) && {
+    // The result is wider than this vector, so it can't be calculated in place.
+    if (numBits < other.numBits) {
+        return *this - other;
     }
-    return move(result);
+    return move(*this -= other);
 }
 
 /**
  * @brief Multiplication operator for vec4state.
  * 
- * Calculates the product of this vector and other vector. The method aligns the vectors to the same size, and then multiplies each VPI in this vector by each VPI in other vector and adds the result to the corresponding VPI in the result vector.
+ * Calculates the product of this vector and other vector. The product is calculated into the result vector (using v4::mul), by Comba multiplication of the limbs, or by Karatsuba multiplication if the vectors are wide. The product is truncated to the number of bits of the longer vector.
  * 
  * @param other The vector to multiply.
  * @return A new vector that holds the result of the multiplication operation. If one of the vectors holds unknown bits, then the result is only x's.
  */
 vec4state vec4state::operator*(const vec4state& other) const {
-    long long maxNumBits = max(numBits, other.numBits);
-    if (unknown || other.unknown) {
-        return vec4state(X, maxNumBits);
-    }
-    vec4state result = vec4state(ZERO, maxNumBits);
-    // Align the vectors to the same size.
-    vec4state copyThis = *this;
-    vec4state copyOther = other;
-    copyThis.setNumBits(maxNumBits);
-    copyOther.setNumBits(maxNumBits);
-    // for each VPI in this vector, multiply it by each VPI in other vector and add the result to the corresponding VPI in the result vector.
-    long long carry = 0;
-    for (int idxThis = 0; idxThis < maxNumBits; idxThis++) {
-        for (int idxOther = 0; idxOther < maxNumBits; idxOther++) {
-            long long mul = long long(copyThis.vector[idxThis].getAval()) * long long(copyOther.vector[idxOther].getAval());
-            long long newResult = result.vector[max(idxThis, idxOther)].getAval() + mul + carry;
-            if (newResult > MASK_32) {
-                carry = newResult >> BITS_IN_VPI;
-                newResult = newResult & MASK_32;
-            } else {
-                carry = 0;
-            }
-            // Add the lower 32 bits of the multiplication to the result vector.
-            result.vector[max(idxThis, idxOther)].setAval(uint32_t(newResult));
-        }
-    }
-    // If there is a carry in the last iteration, increase the size of the result vector by 1.
-    if (carry) {
-        result.incNumBits(maxNumBits + 1);
-        result.vector[maxNumBits].setAval(uint32_t(carry));
-    }
-    return move(result);
+    vec4state result;
+    v4::mul(result, *this, other);
+    return result;
 }
 
 /**
  * @brief Division operator for vec4state.
  * 
- * Calculates the division of this vector by other vector. If other is 0, vec4stateExceptionInvalidOperation is thrown.
+ * Calculates the division of this vector by other vector (using v4::divmod). If other is 0, vec4stateExceptionInvalidOperation is thrown.
  * 
  * @param other The vector to divide by.
  * @return A new vector that holds the result of the division operation. If one of the vectors holds unknown bits, then the result is only x's.
  */
 vec4state vec4state::operator/(const vec4state& other) const {
-    // If other is 0, throw an exception.
-    if (!other) {
-        throw vec4stateExceptionInvalidOperation("Division by zero is not allowed");
-    }
-    // Hold the maximal number of bits between the two vectors.
-    long long maxNumBits = max(numBits, other.numBits);
-    // If one of the vectors holds unknown bits, the result is unknown.
-    if (unknown || other.unknown) {
-        return vec4state(X, maxNumBits);
-    }
-    // Initialize the result vector.
-    vec4state result = vec4state(ZERO, maxNumBits);
-    // Align the vectors to the same size.
-    vec4state copyThis = *this;
-    vec4state copyOther = other;
-    copyThis.setNumBits(maxNumBits);
-    copyOther.setNumBits(maxNumBits);
-    // Divide the vectors using bit manipulation.
-    // While copyThis (dividend) is greater than or equal to copyOther(divisor), continue dividing.
-    while (copyThis >= copyOther) {
-        long long shift = 0;
-        // Find the maximal shift that is less than or equal to the division result.
-        while (copyThis > (copyOther << (shift + 1))) {
-            shift++;
-        }
-        // Subtract the divisor multiplied by 2^shift (2^shift = 1 << shift) from this.
-        copyThis = copyThis - (copyOther << shift);
-        // Add 2^shift to the result.
-        result = result + (vec4state(1) << shift);
-        // Continue the process until copyThis is less than copyOther, meaning can't get an integer result from the division.
-    }
-    return move(result);
+    vec4state quotient;
+    vec4state remainder;
+    v4::divmod(quotient, remainder, *this, other);
+    return quotient;
 }
 
 /**
  * @brief Modulus operator for vec4state.
  * 
- * Calculates the modulus of this vector by other vector. If other is 0, vec4stateExceptionInvalidOperation is thrown.
+ * Calculates the modulus of this vector by other vector (using v4::divmod). If other is 0, vec4stateExceptionInvalidOperation is thrown.
  * 
  * @param other The vector to calculate the modulus by.
  * @return A new vector that holds the result of the modulus operation. If one of the vectors holds unknown bits, then the result is only x's.
  */
 vec4state vec4state::operator%(const vec4state& other) const {
-    // If other is 0, throw an exception.
-    if (!other) {
-        throw vec4stateExceptionInvalidOperation("Division by zero is not allowed");
-    }
-    // Hold the maximal number of bits between the two vectors.
-    long long maxNumBits = max(numBits, other.numBits);
-    // If one of the vectors holds unknown bits, the result is unknown.
-    if (unknown || other.unknown) {
-        return vec4state(X, maxNumBits);
-    }
-    // Align the vectors to the same size.
-    vec4state copyThis = *this;
-    vec4state copyOther = other;
-    copyThis.setNumBits(maxNumBits);
-    copyOther.setNumBits(maxNumBits);
-    // Divide the vectors using bit manipulation and extract the remainder.
-    // Using the same method as the division operator, but instead of adding 2^shift to the result, subtract the divisor multiplied by 2^shift from this.
-    // Meaning, subtract the result of the division multiplied by the divisor from this. The result is the remainder.
-    // While copyThis (dividend) is greater than or equal to copyOther(divisor), continue dividing.
-    while (copyThis >= copyOther) {
-        // Find the maximal shift that is less than or equal to the division result.
-        long long shift = 0;
-        while (copyThis > (copyOther << (shift + 1))) {
-            shift++;
-        }
-        // Subtract the divisor multiplied by 2^shift (2^shift = 1 << shift) from this.
-        // The result is the remainder of the current division.
-        copyThis = copyThis - (copyOther << shift);
-        // Continue the process until copyThis is less than copyOther, meaning can't get an integer result from the division. In this case, copyThis is the remainder.
-    }
-    return move(copyThis);
+    vec4state quotient;
+    vec4state remainder;
+    v4::divmod(quotient, remainder, *this, other);
+    return remainder;
 }
 
 /**
@@ -1505,60 +2878,278 @@ vec4state vec4state::power(const vec4state& other) const {
     return move(result);
 }
 
+/**
+ * @brief Lookup table that spreads the bits of a byte into the bytes of a word.
+ * 
+ * Byte k of the word at index byte (in memory order) is 1 if bit 7 - k of byte is set, and 0 otherwise, so the first byte belongs to the most significant bit, as in the string representation of a vector.
+ */
+struct BitSpreadTable {
+    /**
+     * @brief The spread words of every byte.
+     */
+    uint64_t words[256];
+
+    /**
+     * @brief Fills the words of the table.
+     */
+    BitSpreadTable() {
+        for (int byte = 0; byte < 256; byte++) {
+            unsigned char spreadBits[8];
+            for (int k = 0; k < 8; k++) {
+                spreadBits[k] = (byte >> (7 - k)) & 1;
+            }
+            memcpy(&words[byte], spreadBits, sizeof(spreadBits));
+        }
+    }
+};
+
 /**
  * @brief String representation of the vector.
  * 
- * Creates a string representation of the vecor, where each bit is represented by it's corresponding BitValue (0, 1, x, or z). This is done by iterating over the vector's VPIs from MSB to LSB, and for each VPI, iterating over the bits in it from MSB to LSB and adding the corresponding BitValue to the result string.
+ * Creates a string representation of the vecor, where each bit is represented by it's corresponding BitValue (0, 1, x, or z). The string is allocated once with the size of the vector and filled by toChars.
  * 
  * @return A string representation of the vector.
  */
 string vec4state::toString() const {
-    string result;
-    // Iterate over the vector's VPIs from MSB to LSB.
-    // i represents the index of the VPI in the vector.
-    for (long long i = vectorSize - 1; i >= 0; i--) {
-        uint32_t currAval = vector[i].getAval();
-        uint32_t currBval = vector[i].getBval();
-        // Iterate over the bits in the VPI from MSB to LSB.
-        for (int j = 31; j >= 0; j--) {
-            // j represents the index of the bit in the VPI.
-            // If the current VPI is the last one and the number of bits is not a multiple of 32 and the current bit is out of range, continue.
-            if (i == vectorSize - 1 && numBits % BITS_IN_VPI != 0 && j > (numBits % BITS_IN_VPI) - 1) {
-                continue;
-            }
-            // Otherwise, the current bit is in range, add the corresponding BitValue to the result string.
-            // Calculate the mask for the current bit.
-            uint32_t mask = 1 << j;
-            // If the current bit is a z bit, add 'z' to the result string.
-            if ((currAval & mask) && (currBval & mask)) {
-                result += Z;
-            // If the current bit is a 1 bit, add '1' to the result string.
-            } else if (currAval & mask) {
-                result += ONE;
-            // If the current bit is a x bit, add 'x' to the result string.
-            } else if (currBval & mask) {
-                result += X;
-            // If the current bit is a 0 bit, add '0' to the result string.
-            } else {
-                result += ZERO;
+    string result(size_t(numBits), ZERO);
+    toChars(&result[0], result.size());
+    return result;
+}
+
+/**
+ * @brief Writes the string representation of the vector into a buffer.
+ * 
+ * Writes the BitValues of the vector (0, 1, x, or z) from the MSB to the LSB into buf, in the style of std::to_chars: the characters are not null-terminated and no memory is allocated. Every 8 bits are translated to 8 characters at once, using a lookup table that spreads each bit of a byte of the aval and bval planes into a byte of a word, and calculating the characters of the word with a few additions.
+ * 
+ * @param buf The buffer to write into.
+ * @param len The size of the buffer, must be at least the number of bits in the vector.
+ * @return A to_chars_result whose ptr points one past the last written character. If len is less than the number of bits in the vector, ec is errc::value_too_large, ptr is buf + len and the contents of the buffer are unspecified.
+ */
+to_chars_result vec4state::toChars(char* buf, size_t len) const {
+    if (len < size_t(numBits)) {
+        return {buf + len, errc::value_too_large};
+    }
+    static const BitSpreadTable spreadTable;
+    char* currChar = buf;
+    // The most significant bits that don't fill a byte are written one at a time.
+    for (long long bit = numBits - 1; bit >= numBits - numBits % 8; bit--) {
+        bool currAval = (aval[bit / BITS_IN_LIMB] >> (bit % BITS_IN_LIMB)) & 1;
+        bool currBval = (bval[bit / BITS_IN_LIMB] >> (bit % BITS_IN_LIMB)) & 1;
+        *currChar++ = currBval ? (currAval ? Z : X) : (currAval ? ONE : ZERO);
+    }
+    // Each byte of the word is 0 + a + a * b + (x - 0) * b, which is 0, 1, x or z ('x' + 2 == 'z'). Every byte is at most 'z', so the additions never carry into the next byte.
+    const uint64_t onesBytes = 0x0101010101010101ULL;
+    for (long long bit = numBits - numBits % 8 - 8; bit >= 0; bit -= 8) {
+        uint64_t avalBytes = spreadTable.words[(aval[bit / BITS_IN_LIMB] >> (bit % BITS_IN_LIMB)) & 0xFF];
+        uint64_t bvalBytes = spreadTable.words[(bval[bit / BITS_IN_LIMB] >> (bit % BITS_IN_LIMB)) & 0xFF];
+        uint64_t chars = onesBytes * uint64_t(ZERO) + avalBytes + (avalBytes & bvalBytes) + bvalBytes * uint64_t(X - ZERO);
+        memcpy(currChar, &chars, sizeof(chars));
+        currChar += sizeof(chars);
+    }
+    return {currChar, errc()};
+}
+
+/**
+ * @brief The character of a digit that holds unknown bits.
+ * 
+ * Follows the rules of SystemVerilog $display: x if all the bits of the digit are x, z if all the bits are z, X if some of the bits are x, and Z otherwise (some of the bits are z, and the rest are known).
+ * 
+ * @param hasKnownBits true if some of the bits of the digit are known.
+ * @param hasXBits true if some of the bits of the digit are x.
+ * @param hasZBits true if some of the bits of the digit are z.
+ * @return The character of the digit.
+ */
+char unknownDigitChar(bool hasKnownBits, bool hasXBits, bool hasZBits) {
+    if (!hasKnownBits && !hasZBits) {
+        return 'x';
+    }
+    if (!hasKnownBits && !hasXBits) {
+        return 'z';
+    }
+    return hasXBits ? 'X' : 'Z';
+}
+
+/**
+ * @brief Writes the decimal digits of a number that is stored in limbs.
+ * 
+ * Writes exactly numDigits decimal digits of the number (with leading zeros) into the numDigits characters that end at end, where numDigits must be at least the number of digits of the number. Numbers of more than DECIMAL_BASECASE_LIMBS limbs are divided by the largest power 10^(DECIMAL_DIGITS_IN_CHUNK * 2^k) in powers that has at most half of their limbs (using divideLimbs), and the quotient and the remainder are written recursively, so the cost of the conversion is dominated by a few large divisions instead of one division of the whole number for every chunk of digits. Smaller numbers are divided by DECIMAL_CHUNK limb by limb.
+ * 
+ * @param limbs The limbs of the number, from the least significant limb.
+ * @param numLimbs The number of limbs in limbs.
+ * @param end One past the last character to write.
+ * @param numDigits The number of digits to write.
+ * @param powers The powers 10^(DECIMAL_DIGITS_IN_CHUNK * 2^k), where powers[k] holds the limbs of each power without leading zero limbs.
+ */
+void writeDecimalDigits(const limb_t* limbs, long long numLimbs, char* end, long long numDigits, const vector<vector<limb_t>>& powers) {
+    while (numLimbs > 0 && limbs[numLimbs - 1] == 0) {
+        numLimbs--;
+    }
+    // Find the largest power that has at most half of the limbs of the number.
+    size_t power = 0;
+    while (power + 1 < powers.size() && powers[power + 1].size() * 2 <= size_t(numLimbs)) {
+        power++;
+    }
+    if (numLimbs > DECIMAL_BASECASE_LIMBS && powers[power].size() * 2 <= size_t(numLimbs)) {
+        const vector<limb_t>& divisor = powers[power];
+        long long divisorNumLimbs = divisor.size();
+        long long quotientNumLimbs = numLimbs - divisorNumLimbs + 1;
+        vector<limb_t> quotient(quotientNumLimbs);
+        vector<limb_t> remainder(divisor.size());
+        divideLimbs(limbs, numLimbs, divisor.data(), divisorNumLimbs, quotient.data(), remainder.data());
+        // The remainder is less than the power, so it has at most lowDigits digits, and the quotient has the rest of the digits.
+        long long lowDigits = DECIMAL_DIGITS_IN_CHUNK << power;
+        writeDecimalDigits(remainder.data(), divisorNumLimbs, end, lowDigits, powers);
+        writeDecimalDigits(quotient.data(), quotientNumLimbs, end - lowDigits, numDigits - lowDigits, powers);
+        return;
+    }
+    limb_t quotient[DECIMAL_BASECASE_LIMBS];
+    for (long long i = 0; i < numLimbs; i++) {
+        quotient[i] = limbs[i];
+    }
+    char* currChar = end;
+    while (currChar > end - numDigits) {
+        limb_t chunk = 0;
+        for (long long i = numLimbs - 1; i >= 0; i--) {
+            quotient[i] = divWide(chunk, quotient[i], DECIMAL_CHUNK, chunk);
+        }
+        while (numLimbs > 0 && quotient[numLimbs - 1] == 0) {
+            numLimbs--;
+        }
+        for (int digit = 0; digit < DECIMAL_DIGITS_IN_CHUNK && currChar > end - numDigits; digit++) {
+            *--currChar = char(ZERO + chunk % 10);
+            chunk /= 10;
+        }
+    }
+}
+
+/**
+ * @brief String representation of the vector in a radix.
+ * 
+ * Creates a string representation of the vector in binary (as in toString()), octal, decimal or hexadecimal, like the %b, %o, %d and %h formats of SystemVerilog $display. Octal and hexadecimal digits are calculated directly from the aval and bval bits of each digit (using toPowerOfTwoRadixString), and the decimal digits are calculated by divide-and-conquer base conversion (using toDecimalString). If radix is not 2, 8, 10 or 16, vec4stateExceptionInvalidInput is thrown.
+ * 
+ * @param radix The radix to represent the vector in.
+ * @return A string representation of the vector in radix.
+ */
+string vec4state::toString(int radix) const {
+    switch (radix) {
+        case 2:
+            return toString();
+        case 8:
+            return toPowerOfTwoRadixString(3);
+        case 10:
+            return toDecimalString();
+        case 16:
+            return toPowerOfTwoRadixString(4);
+        default:
+            throw vec4stateExceptionInvalidInput("Radix must be 2, 8, 10 or 16");
+    }
+}
+
+/**
+ * @brief Octal or hexadecimal representation of the vector.
+ * 
+ * Creates a string of all the digits of the vector (with leading zeros), where each digit is made of bitsInDigit bits of the aval and bval planes, from the most significant digit. A digit that holds only known bits is written in lowercase, and a digit that holds unknown bits is written as x, z, X or Z (using unknownDigitChar). The most significant digit is made only of the bits that are in range.
+ * 
+ * @param bitsInDigit The number of bits in a digit, 3 for octal or 4 for hexadecimal.
+ * @return The digits of the vector.
+ */
+string vec4state::toPowerOfTwoRadixString(int bitsInDigit) const {
+    static const char digitChars[] = "0123456789abcdef";
+    long long numDigits = (numBits + bitsInDigit - 1) / bitsInDigit;
+    string result(size_t(numDigits), ZERO);
+    char* currChar = &result[0] + numDigits;
+    const limb_t* avalPlane = aval;
+    const limb_t* bvalPlane = bval;
+    limb_t fullDigitMask = (limb_t(1) << bitsInDigit) - 1;
+    for (long long bit = 0; bit < numBits; bit += bitsInDigit) {
+        long long limbIndex = bit / BITS_IN_LIMB;
+        int offset = bit % BITS_IN_LIMB;
+        // If the digits don't cross limbs (hexadecimal), a whole limb in range that holds only known bits is written without checking each digit.
+        if (BITS_IN_LIMB % bitsInDigit == 0 && offset == 0 && numBits - bit >= BITS_IN_LIMB && bvalPlane[limbIndex] == 0) {
+            limb_t currAval = avalPlane[limbIndex];
+            for (int digit = 0; digit < BITS_IN_LIMB / bitsInDigit; digit++) {
+                *--currChar = digitChars[currAval & fullDigitMask];
+                currAval >>= bitsInDigit;
             }
+            bit += BITS_IN_LIMB - bitsInDigit;
+            continue;
+        }
+        limb_t digitAval = avalPlane[limbIndex] >> offset;
+        limb_t digitBval = bvalPlane[limbIndex] >> offset;
+        // An octal digit might continue in the next limb.
+        if (offset + bitsInDigit > BITS_IN_LIMB && limbIndex + 1 < numLimbs) {
+            digitAval |= avalPlane[limbIndex + 1] << (BITS_IN_LIMB - offset);
+            digitBval |= bvalPlane[limbIndex + 1] << (BITS_IN_LIMB - offset);
+        }
+        // The bits of the most significant digit that are out of range are 0's, so only the bits that are in range are checked for unknown bits.
+        limb_t digitMask = (numBits - bit >= bitsInDigit) ? fullDigitMask : (limb_t(1) << (numBits - bit)) - 1;
+        digitAval &= digitMask;
+        digitBval &= digitMask;
+        if (digitBval == 0) {
+            *--currChar = digitChars[digitAval];
+        } else {
+            *--currChar = unknownDigitChar(digitBval != digitMask, (digitBval & ~digitAval) != 0, (digitBval & digitAval) != 0);
         }
     }
     return result;
 }
 
+/**
+ * @brief Decimal representation of the vector.
+ * 
+ * Creates a string of the unsigned decimal value of the vector, without leading zeros. The powers 10^(DECIMAL_DIGITS_IN_CHUNK * 2^k) that are needed for the vector are calculated by squaring (using multiplyLimbs), and the digits are written by divide-and-conquer base conversion (using writeDecimalDigits). If the vector holds unknown bits, the result is a single x, z, X or Z (using unknownDigitChar).
+ * 
+ * @return The decimal digits of the vector.
+ */
+string vec4state::toDecimalString() const {
+    if (unknown) {
+        limb_t knownBits = 0, xBits = 0, zBits = 0;
+        for (long long i = 0; i < numLimbs; i++) {
+            limb_t inRangeMask = (i == numLimbs - 1 && numBits % BITS_IN_LIMB != 0) ? (limb_t(1) << (numBits % BITS_IN_LIMB)) - 1 : MASK_LIMB;
+            knownBits |= ~bval[i] & inRangeMask;
+            xBits |= bval[i] & ~aval[i];
+            zBits |= bval[i] & aval[i];
+        }
+        return string(1, unknownDigitChar(knownBits != 0, xBits != 0, zBits != 0));
+    }
+    long long usedNumLimbs = numLimbs;
+    while (usedNumLimbs > 0 && aval[usedNumLimbs - 1] == 0) {
+        usedNumLimbs--;
+    }
+    if (usedNumLimbs == 0) {
+        return string(1, ZERO);
+    }
+    vector<vector<limb_t>> powers(1, vector<limb_t>(1, DECIMAL_CHUNK));
+    // A power is needed only if it has at most half of the limbs of the number, so the squares stop at a quarter of the limbs.
+    while (powers.back().size() * 4 <= size_t(usedNumLimbs)) {
+        const vector<limb_t>& lastPower = powers.back();
+        long long lastPowerNumLimbs = lastPower.size();
+        vector<limb_t> square(lastPower.size() * 2);
+        multiplyLimbs(lastPower.data(), lastPowerNumLimbs, lastPower.data(), lastPowerNumLimbs, square.data());
+        while (square.back() == 0) {
+            square.pop_back();
+        }
+        powers.push_back(move(square));
+    }
+    // log10(2) < 0.30103, so the number of bits bounds the number of digits from above.
+    long long numDigits = numBits * 30103 / 100000 + 1;
+    string result(size_t(numDigits), ZERO);
+    writeDecimalDigits(aval, usedNumLimbs, &result[0] + numDigits, numDigits, powers);
+    return result.substr(result.find_first_not_of(ZERO));
+}
+
 /**
  * @brief Bool conversion operator for vec4state.
  * 
- * Checks if the vector holds at least one 1 bit. This is done by iterating over the vector's VPIs, and checking if at least one of the VPIs has a bit set to 1.
+ * Checks if the vector holds at least one 1 bit. This is done by iterating over the vector's limbs, and checking if at least one of the limbs has a bit set to 1.
  * 
  * @return true if the vector holds at least one 1 bit.
  * @return false if the vector holds only 0 or unknown bits.
  */
 vec4state::operator bool() const {
     // If the vector has at least one bit set to 1, return true.
-    for (long long i = 0; i < vectorSize; i++) {
-        uint32_t oneBits = vector[i].getKnownBits();
+    for (long long i = 0; i < numLimbs; i++) {
+        limb_t oneBits = (aval[i] & ~bval[i]);
         if (oneBits != 0) {
             return true;
         }
@@ -1570,14 +3161,15 @@ vec4state::operator bool() const {
 /**
  * @brief Conversion operator to vec2state for vec4state.
  * 
- * Converts this vector to a 2-state vector by replacing all the unknown values with 0's. This is done by iterating over the vector's VPIs, setting the z bits to x bits (aval = 0, bval = 1), and then setting the x bits to 0 bits.
+ * Converts this vector to a 2-state vector by replacing all the unknown values with 0's. This is done by iterating over the vector's limbs, setting the z bits to x bits (aval = 0, bval = 1), and then setting the x bits to 0 bits.
  */
 void vec4state::convertTo2State() {
-    for (int i = 0; i < vectorSize; i++) {
+    makeUnique();
+    for (int i = 0; i < numLimbs; i++) {
         // Replace the z bits with x bits.
-        vector[i].setAval(vector[i].getKnownBits());
+        aval[i] = (aval[i] & ~bval[i]);
         // Zero down the unknown bits.
-        vector[i].setBval(0);
+        bval[i] = 0;
     }
     unknown = false;
 }
@@ -1594,10 +3186,46 @@ long long vec4state::getNumBits() const {
 /**
  * @brief Gets the vector of the VPI elements in this vector.
  * 
+ * The values are stored in separate aval and bval planes of limbs, so this method materializes a new array of 32-bit VPI elements from the planes. Changes to the returned array do not affect this vector. If the vector has been moved from, nullptr is returned.
+ * 
  * @return The vector of the VPI elements in this vector.
  */
 shared_ptr<VPI[]> vec4state::getVector() const {
-    return vector;
+    if (aval == nullptr) {
+        return nullptr;
+    }
+    long long vectorSize = getVectorSize();
+    shared_ptr<VPI[]> copy(new VPI[vectorSize], default_delete<VPI[]>());
+    // Each VPI element holds BITS_IN_VPI bits of a limb.
+    for (long long i = 0; i < vectorSize; i++) {
+        long long limbIndex = i * BITS_IN_VPI / BITS_IN_LIMB;
+        long long shift = i * BITS_IN_VPI % BITS_IN_LIMB;
+        copy[i].setAval(uint32_t(aval[limbIndex] >> shift));
+        copy[i].setBval(uint32_t(bval[limbIndex] >> shift));
+    }
+    return copy;
+}
+
+/**
+ * @brief Gets the aval plane of this vector.
+ * 
+ * The aval plane holds the aval limbs of the vector contiguously, starting from the least significant limb. On the heap, the plane is aligned to PLANE_ALIGNMENT bytes.
+ * 
+ * @return A pointer to the first of getNumLimbs() aval limbs.
+ */
+const limb_t* vec4state::getAvalPlane() const {
+    return aval;
+}
+
+/**
+ * @brief Gets the bval plane of this vector.
+ * 
+ * The bval plane holds the bval limbs of the vector contiguously, starting from the least significant limb. On the heap, the plane is aligned to PLANE_ALIGNMENT bytes.
+ * 
+ * @return A pointer to the first of getNumLimbs() bval limbs.
+ */
+const limb_t* vec4state::getBvalPlane() const {
+    return bval;
 }
 
 /**
@@ -1606,7 +3234,16 @@ shared_ptr<VPI[]> vec4state::getVector() const {
  * @return The number of VPI elements in this vector.
  */
 long long vec4state::getVectorSize() const {
-    return vectorSize;
+    return (numBits + BITS_IN_VPI - 1) / BITS_IN_VPI;
+}
+
+/**
+ * @brief Gets the number of limbs in each plane of this vector.
+ * 
+ * @return The number of limbs in each plane of this vector.
+ */
+long long vec4state::getNumLimbs() const {
+    return numLimbs;
 }
 
 /**
@@ -1617,4 +3254,408 @@ long long vec4state::getVectorSize() const {
  */
 bool vec4state::isUnknown() const {
     return unknown;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Bitwise AND into a destination vector.
+ * 
+ * Calculates the bitwise AND of first and second (as in operator&) into dst.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::band(vec4state& dst, const vec4state& first, const vec4state& second) {
+    // If dst is one of the vectors, its values are kept (and zero-extended), so that the vector is read correctly after it is resized.
+    dst.reshape(max(first.numBits, second.numBits), &dst == &first || &dst == &second);
+    const vec4state& shorter = (first.numLimbs <= second.numLimbs) ? first : second;
+    const vec4state& longer = (first.numLimbs <= second.numLimbs) ? second : first;
+    const limb_t* longerAval = longer.aval;
+    const limb_t* longerBval = longer.bval;
+    const limb_t* shorterAval = shorter.aval;
+    const limb_t* shorterBval = shorter.bval;
+    limb_t* resultAval = dst.aval;
+    limb_t* resultBval = dst.bval;
+    limb_t unknownBits = 0;
+    // A known 0 in one of the vectors hides an unknown bit in the other vector, so the result bit is unknown only if none of the bits is a known 0 and not both bits are known 1's.
+    for (long long i = 0; i < shorter.numLimbs; i++) {
+        limb_t oneBits = (longerAval[i] & ~longerBval[i]) & (shorterAval[i] & ~shorterBval[i]);
+        limb_t currBval = (longerAval[i] | longerBval[i]) & (shorterAval[i] | shorterBval[i]) & ~oneBits;
+        resultAval[i] = oneBits;
+        resultBval[i] = currBval;
+        unknownBits |= currBval;
+    }
+    // The shorter vector is zero-extended, so the rest of the result is 0's.
+    for (long long i = shorter.numLimbs; i < longer.numLimbs; i++) {
+        resultAval[i] = 0;
+        resultBval[i] = 0;
+    }
+    dst.unknown = unknownBits != 0;
+}
+
+/**
+ * @brief Bitwise OR into a destination vector.
+ * 
+ * Calculates the bitwise OR of first and second (as in operator|) into dst.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::bor(vec4state& dst, const vec4state& first, const vec4state& second) {
+    // If dst is one of the vectors, its values are kept (and zero-extended), so that the vector is read correctly after it is resized.
+    dst.reshape(max(first.numBits, second.numBits), &dst == &first || &dst == &second);
+    const vec4state& longer = (first.numLimbs >= second.numLimbs) ? first : second;
+    const vec4state& shorter = (first.numLimbs >= second.numLimbs) ? second : first;
+    const limb_t* longerAval = longer.aval;
+    const limb_t* longerBval = longer.bval;
+    const limb_t* shorterAval = shorter.aval;
+    const limb_t* shorterBval = shorter.bval;
+    limb_t* resultAval = dst.aval;
+    limb_t* resultBval = dst.bval;
+    limb_t unknownBits = 0;
+    // A known 1 in one of the vectors hides an unknown bit in the other vector, so the result bit is unknown only if none of the bits is a known 1.
+    for (long long i = 0; i < shorter.numLimbs; i++) {
+        limb_t oneBits = (longerAval[i] & ~longerBval[i]) | (shorterAval[i] & ~shorterBval[i]);
+        resultAval[i] = oneBits;
+        resultBval[i] = (longerBval[i] | shorterBval[i]) & ~oneBits;
+        unknownBits |= resultBval[i];
+    }
+    // The shorter vector is zero-extended, so the rest of the longer vector is ORed with 0's (which turns z's into x's).
+    for (long long i = shorter.numLimbs; i < longer.numLimbs; i++) {
+        resultAval[i] = longerAval[i] & ~longerBval[i];
+        resultBval[i] = longerBval[i];
+        unknownBits |= resultBval[i];
+    }
+    dst.unknown = unknownBits != 0;
+}
+
+/**
+ * @brief Bitwise XOR into a destination vector.
+ * 
+ * Calculates the bitwise XOR of first and second (as in operator^) into dst.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::bxor(vec4state& dst, const vec4state& first, const vec4state& second) {
+    vec4state::bitwiseXorXnor(dst, first, second, false);
+}
+
+/**
+ * @brief Bitwise XNOR into a destination vector.
+ * 
+ * Calculates the bitwise XNOR of first and second (as in xnor) into dst.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::bxnor(vec4state& dst, const vec4state& first, const vec4state& second) {
+    vec4state::bitwiseXorXnor(dst, first, second, true);
+}
+
+/**
+ * @brief Bitwise NOT into a destination vector.
+ * 
+ * Calculates the bitwise NOT of first (as in operator~) into dst.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The vector to negate.
+ */
+void v4::bnot(vec4state& dst, const vec4state& first) {
+    dst.reshape(first.numBits, &dst == &first);
+    // Each bit in the aval is set to 1 only if the bit is 0, and the bval stays the same (so every unknown bit is x).
+    for (long long i = 0; i < dst.numLimbs; i++) {
+        limb_t currBval = first.bval[i];
+        dst.aval[i] = ~(first.aval[i] | currBval);
+        dst.bval[i] = currBval;
+    }
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+    dst.unknown = first.unknown;
+}
+
+/**
+ * @brief Addition into a destination vector.
+ * 
+ * Calculates the sum of first and second (as in operator+) into dst. If the sum has a carry out of the most significant bit, dst has one more bit than the longer vector. If one of the vectors holds unknown bits, dst is set to x's.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::add(vec4state& dst, const vec4state& first, const vec4state& second) {
+    long long maxNumBits = max(first.numBits, second.numBits);
+    bool unknownOperands = first.unknown || second.unknown;
+    dst.reshape(maxNumBits, &dst == &first || &dst == &second);
+    if (unknownOperands) {
+        dst.fill(X);
+        return;
+    }
+    // Each limb is read before it is overwritten, so dst may be one of the vectors.
+    limb_t carry = addLimbs(dst.aval, dst.bval, first.aval, first.numLimbs, second.aval, second.numLimbs, dst.numLimbs);
+    dst.unknown = false;
+    // Find the carry out of the most significant bit, which is either in the last limb or out of it.
+    long long offset = maxNumBits % BITS_IN_LIMB;
+    if (offset != 0) {
+        carry = (dst.aval[dst.numLimbs - 1] >> offset) & 1;
+        dst.aval[dst.numLimbs - 1] &= MASK_LIMB >> (BITS_IN_LIMB - offset);
+    }
+    // If there is a carry out of the most significant bit, increase the size of dst by 1.
+    if (carry) {
+        dst.incNumBits(maxNumBits + 1);
+        dst.aval[maxNumBits / BITS_IN_LIMB] |= limb_t(1) << offset;
+    }
+}
+
+/**
+ * @brief Subtraction into a destination vector.
+ * 
+ * Calculates the difference between first and second (as in operator-) into dst. A negative result is represented in two's complement. If one of the vectors holds unknown bits, dst is set to x's.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The vector to subtract from.
+ * @param second The vector to subtract.
+ */
+void v4::sub(vec4state& dst, const vec4state& first, const vec4state& second) {
+    long long maxNumBits = max(first.numBits, second.numBits);
+    bool unknownOperands = first.unknown || second.unknown;
+    dst.reshape(maxNumBits, &dst == &first || &dst == &second);
+    if (unknownOperands) {
+        dst.fill(X);
+        return;
+    }
+    // Each limb is read before it is overwritten, so dst may be one of the vectors.
+    subLimbs(dst.aval, dst.bval, first.aval, first.numLimbs, second.aval, second.numLimbs, dst.numLimbs);
+    dst.unknown = false;
+    // A negative result borrows beyond the most significant bit, so the bits that are out of range are zeroed down.
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+}
+
+/**
+ * @brief Multiplication into a destination vector.
+ * 
+ * Calculates the product of first and second (as in operator*) into dst, truncated to the number of bits of the longer vector. If dst is one of the operands, the product is calculated into a temporary vector first. If one of the vectors holds unknown bits, dst is set to x's.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::mul(vec4state& dst, const vec4state& first, const vec4state& second) {
+    mulWrap(dst, first, second, max(first.numBits, second.numBits));
+}
+
+/**
+ * @brief Width-preserving addition into a destination vector.
+ * 
+ * Calculates the sum of first and second modulo 2^numBits into dst, where dst has numBits bits and the carry out of its most significant bit is discarded, as in a SystemVerilog assignment to a numBits-bit variable. The operands are zero-extended or truncated to numBits. The width of dst doesn't depend on the values of the operands, so a destination that is reused for results of the same width never allocates memory. If one of the vectors holds unknown bits, dst is set to x's. If numBits is non-positive, vec4stateExceptionInvalidSize is thrown.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ * @param numBits The number of bits in the result.
+ */
+void v4::addWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits) {
+    if (numBits <= 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be greater than 0");
+    }
+    bool unknownOperands = first.unknown || second.unknown;
+    dst.reshape(numBits, &dst == &first || &dst == &second);
+    if (unknownOperands) {
+        dst.fill(X);
+        return;
+    }
+    // Each limb is read before it is overwritten, so dst may be one of the vectors.
+    addLimbs(dst.aval, dst.bval, first.aval, first.numLimbs, second.aval, second.numLimbs, dst.numLimbs);
+    dst.unknown = false;
+    // The carry out of the most significant bit is discarded.
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+}
+
+/**
+ * @brief Width-preserving addition into a destination vector.
+ * 
+ * Calculates the sum of first and second into dst (as in addWrap), with the number of bits of the longer vector.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::addWrap(vec4state& dst, const vec4state& first, const vec4state& second) {
+    addWrap(dst, first, second, max(first.getNumBits(), second.getNumBits()));
+}
+
+/**
+ * @brief Width-preserving multiplication into a destination vector.
+ * 
+ * Calculates the product of first and second modulo 2^numBits into dst, where dst has numBits bits, as in a SystemVerilog assignment to a numBits-bit variable. Only the limbs of the product that fall within numBits bits are calculated, by Comba multiplication, or by Karatsuba multiplication if the operands are wide. The operands are zero-extended or truncated to numBits, and a destination that is reused for results of the same width never allocates memory, unless it is one of the operands or the operands are wide enough for Karatsuba multiplication, which needs temporary limbs. If one of the vectors holds unknown bits, dst is set to x's. If numBits is non-positive, vec4stateExceptionInvalidSize is thrown.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ * @param numBits The number of bits in the result.
+ */
+void v4::mulWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits) {
+    if (numBits <= 0) {
+        throw vec4stateExceptionInvalidSize("Number of bits must be greater than 0");
+    }
+    // The product is written into the limbs of dst while the vectors are read, so if dst is one of the vectors, it is calculated into a temporary vector first.
+    if (&dst == &first || &dst == &second) {
+        vec4state product;
+        mulWrap(product, first, second, numBits);
+        dst.copyFrom(product);
+        return;
+    }
+    dst.reshape(numBits, false);
+    if (first.unknown || second.unknown) {
+        dst.fill(X);
+        return;
+    }
+    multiplyLowLimbs(dst.aval, first.aval, first.numLimbs, second.aval, second.numLimbs, dst.numLimbs);
+    for (long long i = 0; i < dst.numLimbs; i++) {
+        dst.bval[i] = 0;
+    }
+    dst.unknown = false;
+    // The product might have bits that are beyond the most significant bit.
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+}
+
+/**
+ * @brief Width-preserving multiplication into a destination vector.
+ * 
+ * Calculates the product of first and second into dst (as in mulWrap), with the number of bits of the longer vector. This is the same as mul.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The first vector.
+ * @param second The second vector.
+ */
+void v4::mulWrap(vec4state& dst, const vec4state& first, const vec4state& second) {
+    mulWrap(dst, first, second, max(first.getNumBits(), second.getNumBits()));
+}
+
+/**
+ * @brief Division with remainder into destination vectors.
+ * 
+ * Calculates the quotient (as in operator/) and the remainder (as in operator%) of first divided by second in a single long division (Knuth's algorithm D, with a fast path for a divisor of a single limb), into quotient and remainder, which have the number of bits of the longer vector. Only the significant limbs of the vectors take part in the division. If one of the vectors holds unknown bits, quotient and remainder are set to x's. If second is 0, vec4stateExceptionInvalidOperation is thrown. If quotient and remainder are the same vector, vec4stateExceptionInvalidOperation is thrown.
+ * 
+ * @param quotient The vector to write the quotient into.
+ * @param remainder The vector to write the remainder into.
+ * @param first The vector to divide.
+ * @param second The vector to divide by.
+ */
+void v4::divmod(vec4state& quotient, vec4state& remainder, const vec4state& first, const vec4state& second) {
+    if (&quotient == &remainder) {
+        throw vec4stateExceptionInvalidOperation("Quotient and remainder must be different vectors");
+    }
+    if (!second) {
+        throw vec4stateExceptionInvalidOperation("Division by zero is not allowed");
+    }
+    // The results are written while the vectors are read, so if one of the results is one of the vectors, they are calculated into temporary vectors first.
+    if (&quotient == &first || &quotient == &second || &remainder == &first || &remainder == &second) {
+        vec4state tempQuotient;
+        vec4state tempRemainder;
+        divmod(tempQuotient, tempRemainder, first, second);
+        quotient.copyFrom(tempQuotient);
+        remainder.copyFrom(tempRemainder);
+        return;
+    }
+    long long maxNumBits = max(first.numBits, second.numBits);
+    quotient.reshape(maxNumBits, false);
+    remainder.reshape(maxNumBits, false);
+    if (first.unknown || second.unknown) {
+        quotient.fill(X);
+        remainder.fill(X);
+        return;
+    }
+    // Divide only the significant limbs. The divisor isn't 0, so it has at least one.
+    long long dividendNumLimbs = first.numLimbs;
+    while (dividendNumLimbs > 0 && first.aval[dividendNumLimbs - 1] == 0) {
+        dividendNumLimbs--;
+    }
+    long long divisorNumLimbs = second.numLimbs;
+    while (second.aval[divisorNumLimbs - 1] == 0) {
+        divisorNumLimbs--;
+    }
+    long long quotientNumLimbs = 0;
+    long long remainderNumLimbs = 0;
+    if (dividendNumLimbs < divisorNumLimbs) {
+        // The dividend is less than the divisor, so it is the remainder.
+        for (long long i = 0; i < dividendNumLimbs; i++) {
+            remainder.aval[i] = first.aval[i];
+        }
+        remainderNumLimbs = dividendNumLimbs;
+    } else {
+        divideLimbs(first.aval, dividendNumLimbs, second.aval, divisorNumLimbs, quotient.aval, remainder.aval);
+        quotientNumLimbs = dividendNumLimbs - divisorNumLimbs + 1;
+        remainderNumLimbs = divisorNumLimbs;
+    }
+    for (long long i = quotientNumLimbs; i < quotient.numLimbs; i++) {
+        quotient.aval[i] = 0;
+    }
+    for (long long i = remainderNumLimbs; i < remainder.numLimbs; i++) {
+        remainder.aval[i] = 0;
+    }
+    for (long long i = 0; i < quotient.numLimbs; i++) {
+        quotient.bval[i] = 0;
+        remainder.bval[i] = 0;
+    }
+    quotient.unknown = false;
+    remainder.unknown = false;
+}
+
+/**
+ * @brief Logical shift left into a destination vector.
+ * 
+ * Shifts first to the left by num bit positions (as in operator<<) into dst. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in first, dst is set to 0's.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The vector to shift.
+ * @param num The number of bit positions to shift by.
+ */
+void v4::shl(vec4state& dst, const vec4state& first, long long num) {
+    if (&dst == &first) {
+        dst <<= num;
+        return;
+    }
+    dst.reshape(first.numBits, false);
+    // If the number of bit positions to shift by is negative or greater than the number of bits in the vector, the result is a vector of 0's.
+    if (num < 0 || num >= first.numBits) {
+        dst.fill(ZERO);
+        return;
+    }
+    shiftLimbsLeft(dst.aval, dst.bval, first.aval, first.bval, dst.numLimbs, num);
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+    dst.unknown = first.unknown;
+    if (dst.unknown) {
+        dst.setUnknown();
+    }
+}
+
+/**
+ * @brief Logical shift right into a destination vector.
+ * 
+ * Shifts first to the right by num bit positions (as in operator>>) into dst. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in first, dst is set to 0's.
+ * 
+ * @param dst The vector to write the result into.
+ * @param first The vector to shift.
+ * @param num The number of bit positions to shift by.
+ */
+void v4::shr(vec4state& dst, const vec4state& first, long long num) {
+    if (&dst == &first) {
+        dst >>= num;
+        return;
+    }
+    dst.reshape(first.numBits, false);
+    // If the number of bit positions to shift by is negative or greater than the number of bits in the vector, the result is a vector of 0's.
+    if (num < 0 || num >= first.numBits) {
+        dst.fill(ZERO);
+        return;
+    }
+    shiftLimbsRight(dst.aval, dst.bval, first.aval, first.bval, dst.numLimbs, num);
+    zeroDownOutOfRangeBits(dst.aval, dst.bval, dst.numLimbs, dst.numBits);
+    dst.unknown = first.unknown;
+    if (dst.unknown) {
+        dst.setUnknown();
+    }
+}
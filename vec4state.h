@@ -12,10 +12,13 @@
 #define VEC4STATE_H
 
 #include <string>
+#include <charconv>
 #include <stdint.h>
 #include "vpi.h"
+#include "limb.h"
 #include <type_traits>
 #include <memory>
+#include <new>
 #include "vec4stateException.h"
 #include "math.h"
 
@@ -34,6 +37,23 @@
  */
 #define BITS_IN_BYTE 8
 
+/**
+ * @brief The number of VPI elements that are stored inside the vec4state object itself.
+ * 
+ * Vectors of up to INLINE_VECTOR_SIZE VPI elements (128 bits) do not allocate memory on the heap.
+ */
+#define INLINE_VECTOR_SIZE 4
+
+/**
+ * @brief The number of limbs that are stored inside the vec4state object itself.
+ */
+#define INLINE_NUM_LIMBS (INLINE_VECTOR_SIZE * BITS_IN_VPI / BITS_IN_LIMB)
+
+/**
+ * @brief The alignment in bytes of the aval and bval planes that are allocated on the heap.
+ */
+#define PLANE_ALIGNMENT 64
+
 using namespace std;
 
 /**
@@ -49,6 +69,89 @@ enum BitValue {
     Z = 'z'
 };
 
+/**
+ * @brief NumberStatus is the result of converting a vector to a number with tryToUint64.
+ */
+enum NumberStatus {
+    NUMBER_OK,
+    NUMBER_UNKNOWN,
+    NUMBER_TOO_LARGE
+};
+
+/**
+ * @brief logic holds a single bit of a 4-state vector (0, 1, x or z) in 2 bits.
+ * 
+ * The bits are stored as in the planes of a vector: bit 0 is the aval bit and bit 1 is the bval bit, so 0, 1, x and z are 0, 1, 2 and 3. Reading a bit of a vector into a logic doesn't allocate memory, unlike reading it into a vector of 1 bit.
+ */
+struct logic {
+    /**
+     * @brief The aval bit (bit 0) and the bval bit (bit 1).
+     */
+    uint8_t value;
+
+    /**
+     * @brief Default constructor for logic, initializes the bit to 0.
+     */
+    constexpr logic() : value(0) {}
+
+    /**
+     * @brief Constructor for logic from the aval and bval bits.
+     * 
+     * @param avalBit The aval bit.
+     * @param bvalBit The bval bit.
+     */
+    constexpr logic(bool avalBit, bool bvalBit) : value(uint8_t((bvalBit ? 2 : 0) | (avalBit ? 1 : 0))) {}
+
+    /**
+     * @brief Constructor for logic from a BitValue.
+     * 
+     * @param bit The value of the bit. A character that is not a BitValue is translated to x.
+     */
+    constexpr logic(BitValue bit) : value(bit == ZERO ? 0 : (bit == ONE ? 1 : (bit == Z ? 3 : 2))) {}
+
+    /**
+     * @brief Returns the aval bit.
+     */
+    constexpr bool getAval() const {
+        return value & 1;
+    }
+
+    /**
+     * @brief Returns the bval bit.
+     */
+    constexpr bool getBval() const {
+        return (value >> 1) & 1;
+    }
+
+    /**
+     * @brief Checks if the bit is unknown (x or z).
+     */
+    constexpr bool isUnknown() const {
+        return getBval();
+    }
+
+    /**
+     * @brief Returns the BitValue of the bit.
+     */
+    constexpr BitValue toBitValue() const {
+        return value == 0 ? ZERO : (value == 1 ? ONE : (value == 2 ? X : Z));
+    }
+
+    /**
+     * @brief Case equality operator for logic, where x and z are compared as values.
+     */
+    constexpr bool operator==(logic other) const {
+        return value == other.value;
+    }
+
+    /**
+     * @brief Case inequality operator for logic, where x and z are compared as values.
+     */
+    constexpr bool operator!=(logic other) const {
+        return value != other.value;
+    }
+};
+
 /**
  * @brief Type trait to check if a type is a valid type for a vec4state constructor.
  * 
@@ -59,11 +162,187 @@ enum BitValue {
 template <typename T>
 struct is_valid_type_for_vec4state : integral_constant<bool, is_integral<T>::value || is_same<T, std::string>::value || is_same<T, const char*>::value || is_same<T, BitValue>::value> {};
 
+class vec4state;
+
+/**
+ * @brief Three-address operators for vec4state.
+ * 
+ * The functions in this namespace write the result of an operator into a destination vector that is owned by the caller, instead of returning a new vector. The destination takes the number of bits of the result (as the corresponding operator returns it), and its planes are reallocated only if they are shared with another vector or if the destination doesn't have enough capacity for the result. A destination that is reused for results of the same size never allocates memory. The destination may also be one of the operands.
+ */
+namespace v4 {
+    /**
+     * @brief Bitwise AND into a destination vector.
+     * 
+     * Calculates the bitwise AND of first and second (as in operator&) into dst.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void band(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Bitwise OR into a destination vector.
+     * 
+     * Calculates the bitwise OR of first and second (as in operator|) into dst.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void bor(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Bitwise XOR into a destination vector.
+     * 
+     * Calculates the bitwise XOR of first and second (as in operator^) into dst.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void bxor(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Bitwise XNOR into a destination vector.
+     * 
+     * Calculates the bitwise XNOR of first and second (as in xnor) into dst.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void bxnor(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Bitwise NOT into a destination vector.
+     * 
+     * Calculates the bitwise NOT of first (as in operator~) into dst.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The vector to negate.
+     */
+    void bnot(vec4state& dst, const vec4state& first);
+
+    /**
+     * @brief Addition into a destination vector.
+     * 
+     * Calculates the sum of first and second (as in operator+) into dst. If the sum has a carry out of the most significant bit, dst has one more bit than the longer vector. If one of the vectors holds unknown bits, dst is set to x's.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void add(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Subtraction into a destination vector.
+     * 
+     * Calculates the difference between first and second (as in operator-) into dst. A negative result is represented in two's complement. If one of the vectors holds unknown bits, dst is set to x's.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The vector to subtract from.
+     * @param second The vector to subtract.
+     */
+    void sub(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Multiplication into a destination vector.
+     * 
+     * Calculates the product of first and second (as in operator*) into dst, truncated to the number of bits of the longer vector. If dst is one of the operands, the product is calculated into a temporary vector first. If one of the vectors holds unknown bits, dst is set to x's.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void mul(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Width-preserving addition into a destination vector.
+     * 
+     * Calculates the sum of first and second modulo 2^numBits into dst, where dst has numBits bits and the carry out of its most significant bit is discarded, as in a SystemVerilog assignment to a numBits-bit variable. The operands are zero-extended or truncated to numBits. The width of dst doesn't depend on the values of the operands, so a destination that is reused for results of the same width never allocates memory. If one of the vectors holds unknown bits, dst is set to x's. If numBits is non-positive, vec4stateExceptionInvalidSize is thrown.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     * @param numBits The number of bits in the result.
+     */
+    void addWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits);
+
+    /**
+     * @brief Width-preserving addition into a destination vector.
+     * 
+     * Calculates the sum of first and second into dst (as in addWrap), with the number of bits of the longer vector.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void addWrap(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Width-preserving multiplication into a destination vector.
+     * 
+     * Calculates the product of first and second modulo 2^numBits into dst, where dst has numBits bits, as in a SystemVerilog assignment to a numBits-bit variable. Only the limbs of the product that fall within numBits bits are calculated, by Comba multiplication, or by Karatsuba multiplication if the operands are wide. The operands are zero-extended or truncated to numBits, and a destination that is reused for results of the same width never allocates memory, unless it is one of the operands or the operands are wide enough for Karatsuba multiplication, which needs temporary limbs. If one of the vectors holds unknown bits, dst is set to x's. If numBits is non-positive, vec4stateExceptionInvalidSize is thrown.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     * @param numBits The number of bits in the result.
+     */
+    void mulWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits);
+
+    /**
+     * @brief Width-preserving multiplication into a destination vector.
+     * 
+     * Calculates the product of first and second into dst (as in mulWrap), with the number of bits of the longer vector. This is the same as mul.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     */
+    void mulWrap(vec4state& dst, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Division with remainder into destination vectors.
+     * 
+     * Calculates the quotient (as in operator/) and the remainder (as in operator%) of first divided by second in a single long division (Knuth's algorithm D, with a fast path for a divisor of a single limb), into quotient and remainder, which have the number of bits of the longer vector. Only the significant limbs of the vectors take part in the division. If one of the vectors holds unknown bits, quotient and remainder are set to x's. If second is 0, vec4stateExceptionInvalidOperation is thrown. If quotient and remainder are the same vector, vec4stateExceptionInvalidOperation is thrown.
+     * 
+     * @param quotient The vector to write the quotient into.
+     * @param remainder The vector to write the remainder into.
+     * @param first The vector to divide.
+     * @param second The vector to divide by.
+     */
+    void divmod(vec4state& quotient, vec4state& remainder, const vec4state& first, const vec4state& second);
+
+    /**
+     * @brief Logical shift left into a destination vector.
+     * 
+     * Shifts first to the left by num bit positions (as in operator<<) into dst. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in first, dst is set to 0's.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The vector to shift.
+     * @param num The number of bit positions to shift by.
+     */
+    void shl(vec4state& dst, const vec4state& first, long long num);
+
+    /**
+     * @brief Logical shift right into a destination vector.
+     * 
+     * Shifts first to the right by num bit positions (as in operator>>) into dst. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in first, dst is set to 0's.
+     * 
+     * @param dst The vector to write the result into.
+     * @param first The vector to shift.
+     * @param num The number of bit positions to shift by.
+     */
+    void shr(vec4state& dst, const vec4state& first, long long num);
+}
+
 /**
  * @class vec4state
  * @brief This class represents a vector of 4-state values.
  * 
- * This class supports four primary values for each bit in the vector: 0, 1, x and z. The vector can hold up to 2^64 - 1 bits, and it's core functionality is bitwise and arithmetic operations, which are essential for digital logic and circuit design. Those operations include: bitwise, equality, shift, slice, logical, relational, arithmetic and casting 4-state to 2-state. The values are stored as unsigned 32-bit integers, where the 32 least significant bits are stored in the first element of the vector.
+ * This class supports four primary values for each bit in the vector: 0, 1, x and z. The vector can hold up to 2^64 - 1 bits, and it's core functionality is bitwise and arithmetic operations, which are essential for digital logic and circuit design. Those operations include: bitwise, equality, shift, slice, logical, relational, arithmetic and casting 4-state to 2-state. The values are stored in limbs (unsigned 64-bit integers by default, see limb.h), where the least significant bits are stored in the first limb of the vector. The values can still be read as 32-bit VPI elements for VPI interop.
  */
 class vec4state {
 public:
@@ -85,21 +364,27 @@ public:
     template<typename T, typename enable_if<is_integral<T>::value, bool>::type = true>
     vec4state(T num) {
         numBits = sizeof(T) * BITS_IN_BYTE;
-        vectorSize = (numBits + BITS_IN_VPI - 1) / BITS_IN_VPI;
         unknown = false;
-        vector = shared_ptr<VPI[]>(new VPI[vectorSize]);
-        int mask = MASK_32;
-        for (long long i = 0; i < vectorSize; i++) {
-            vector[i].setAval(uint32_t(num & mask));
-            vector[i].setBval(0);
-            num >>= BITS_IN_VPI;
+        allocateVector((numBits + BITS_IN_LIMB - 1) / BITS_IN_LIMB);
+        // Each limb is taken from the low bits of num, which is then shifted down by a whole limb (only if T is wider than a limb).
+        T value = num;
+        for (long long i = 0; i < numLimbs; i++) {
+            aval[i] = limb_t(value);
+            bval[i] = 0;
+            if constexpr (sizeof(T) * BITS_IN_BYTE > BITS_IN_LIMB) {
+                value >>= BITS_IN_LIMB;
+            }
+        }
+        // Negative numbers are sign-extended by the conversion to limb_t, so only the bits of T are kept.
+        if (numBits % BITS_IN_LIMB != 0) {
+            aval[numLimbs - 1] &= MASK_LIMB >> (BITS_IN_LIMB - (numBits % BITS_IN_LIMB));
         }
     }
     
     /**
      * @brief String constructor for vec4state.
      * 
-     * Initializes a vector of size str.length() with the values represented by str. The constructor iterates over the string's characters, translates the BitValues to aval and bval of a VPI, and fills the VPI of vector from last VPI to first VPI with these BitValues. If str contains a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown.
+     * Initializes a vector of size str.length() with the values represented by str. The constructor translates the string's characters to aval and bval of a limb, and fills the limb of vector from last limb to first limb with these BitValues. Whole limbs are classified 16 or 32 characters at a time where SSE2 or AVX2 is available (using fillFullLimbWithStringBits). If str contains a character that is not a BitValue, the vector is initialized to x and vec4stateExceptionInvalidInput is thrown, with the index of the first invalid character in its message.
      * 
      * @param str The value to initialize the vector with, must be a string that holds only BitValues.
      */
@@ -114,10 +399,36 @@ public:
      */
     vec4state(char bit);
 
+    /**
+     * @brief Fill constructor for vec4state.
+     * 
+     * Initializes a vector with a single bit (that can be either 0, 1, x, or z) repeated numBits times. The limbs are filled directly with the aval and bval words of bit (using fill), so creating the vector takes time proportional to the number of limbs. If numBits is non-positive or bit is not a BitValue, vec4stateExceptionInvalidSize or vec4stateExceptionInvalidInput is thrown, respectively.
+     * 
+     * @param bit The bit to repeat.
+     * @param numBits The number of bits in the vector.
+     */
+    vec4state(BitValue bit, long long numBits);
+
+    /**
+     * @brief Creates a vector from a SystemVerilog integer literal.
+     * 
+     * Parses sized and unsized literals, such as 8'hFF, 16'b1x0z, 12'o7_7?, 4'sd5, 'd123, 123 and '1, and builds the aval and bval limbs directly from the digits, without an intermediate binary string. The size is followed by ', an optional s (signedness, which is accepted but doesn't change the bits of the vector), and the base b, o, d or h (case insensitive). Digits can be x/X, z/Z or ?, and underscores between the digits are ignored. As in SystemVerilog:
+     * - A sized literal that has more bits than its size is truncated from the left, and a literal that has fewer bits is zero-extended, or extended with x's or z's if its leftmost digit is x or z.
+     * - An unsized literal (based or decimal) has at least 32 bits, and more if its digits need them.
+     * - A decimal literal can have a single x or z digit, which sets all of its bits.
+     * - An unbased unsized literal ('0, '1, 'x or 'z) is a 1-bit vector, which is its self-determined size.
+     * 
+     * If the literal is malformed, vec4stateExceptionInvalidInput is thrown with the index of the first invalid character, and if its size is 0, vec4stateExceptionInvalidSize is thrown.
+     * 
+     * @param literal The literal to parse.
+     * @return A vector that holds the value of the literal.
+     */
+    static vec4state fromLiteral(const string& literal);
+
     /**
      * @brief Copy constructor for vec4state.
      * 
-     * Initializes a new vector and copies the values from the other vector to the new vector.
+     * Initializes a new vector that holds the values of the other vector. If the other vector is stored on the heap, the new vector shares its planes (copy-on-write), and the planes are cloned only when one of the vectors is changed. Otherwise, the limbs are copied to the inline storage of the new vector.
      * 
      * @param other The vector to copy from.
      */
@@ -135,7 +446,7 @@ public:
     /**
      * @brief Assignment operator for vec4state.
      * 
-     * Assigns the values of other to this vector. If the other vector is shorter than this vector, zeroes down the bits that are out of range.
+     * Assigns the values of other to this vector. If the other vector is shorter than this vector, zeroes down the bits that are out of range. If both vectors have the same number of bits and other vector is stored on the heap, this vector shares the planes of other vector (copy-on-write).
      * 
      * @param other The vector to assign from.
      * @return A reference to this vector.
@@ -160,7 +471,7 @@ public:
     /**
      * @brief Bool conversion operator for vec4state.
      * 
-     * Checks if the vector holds at least one 1 bit. This is done by iterating over the vector's VPIs, and checking if at least one of the VPIs has a bit set to 1.
+     * Checks if the vector holds at least one 1 bit. This is done by iterating over the vector's limbs, and checking if at least one of the limbs has a bit set to 1.
      * 
      * @return true if the vector holds at least one 1 bit.
      * @return false if the vector holds only 0 or unknown bits.
@@ -170,17 +481,47 @@ public:
     /**
      * @brief Bitwise AND operator for vec4state.
      * 
-     * Calculates the bitwise AND of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise NOT of each vector, then calculates the bitwise OR of the NOT vectors, and finally calculates the bitwise NOT of the result vector.
+     * Calculates the bitwise AND of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors and calculates the aval and bval of each limb of the result directly (using v4::band).
      * 
      * @param other The vector to perform the bitwise AND operation with.
      * @return A new vector that holds the result of the bitwise AND operation.
      */
-    vec4state operator&(const vec4state& other) const;
+    vec4state operator&(const vec4state& other) const&;
+
+    /**
+     * @brief Bitwise AND operator for an expiring vec4state.
+     * 
+     * Calculates the bitwise AND of this vector and other vector (as in operator&), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator&=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+     * 
+     * @param other The vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator&(const vec4state& other) &&;
+
+    /**
+     * @brief Bitwise AND operator for vec4state with an expiring vector.
+     * 
+     * Calculates the bitwise AND of this vector and other vector (as in operator&), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator&(vec4state&& other) const&;
+
+    /**
+     * @brief Bitwise AND operator for two expiring vec4state vectors.
+     * 
+     * Calculates the bitwise AND of this vector and other vector (as in operator&), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator&(vec4state&& other) &&;
 
     /**
      * @brief Bitwise AND operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then calculates the bitwise AND of a bit in this vector with the corresponding bit in num, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise NOT of each vector, then calculates the bitwise OR of the NOT vectors, and finally calculates the bitwise NOT of the result vector.
+     * Creates a vec4state that holds the value of num, then calculates the bitwise AND of a bit in this vector with the corresponding bit in num, resulting in one bit for each bit of the vectors. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. If at least one of the bits is unknown, the result bit is x. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors and calculates the aval and bval of each limb of the result directly (using v4::band).
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to perform the bitwise AND operation with.
@@ -199,7 +540,37 @@ public:
      * @param other The vector to perform the bitwise OR operation with.
      * @return A new vector that holds the result of the bitwise OR operation.
      */
-    vec4state operator|(const vec4state& other) const;
+    vec4state operator|(const vec4state& other) const&;
+
+    /**
+     * @brief Bitwise OR operator for an expiring vec4state.
+     * 
+     * Calculates the bitwise OR of this vector and other vector (as in operator|), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator|=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+     * 
+     * @param other The vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator|(const vec4state& other) &&;
+
+    /**
+     * @brief Bitwise OR operator for vec4state with an expiring vector.
+     * 
+     * Calculates the bitwise OR of this vector and other vector (as in operator|), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator|(vec4state&& other) const&;
+
+    /**
+     * @brief Bitwise OR operator for two expiring vec4state vectors.
+     * 
+     * Calculates the bitwise OR of this vector and other vector (as in operator|), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator|(vec4state&& other) &&;
 
     /**
      * @brief Bitwise OR operator for vec4state.
@@ -218,17 +589,47 @@ public:
     /**
      * @brief Bitwise XOR operator for vec4state.
      * 
-     * Calculates the bitwise XOR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise AND between each vector and the bitwise NOT of the other vector, then calculates the bitwise OR of the two results.
+     * Calculates the bitwise XOR of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
      * 
      * @param other The vector to perform the bitwise XOR operation with.
      * @return A new vector that holds the result of the bitwise XOR operation.
      */
-    vec4state operator^(const vec4state& other) const;
+    vec4state operator^(const vec4state& other) const&;
+
+    /**
+     * @brief Bitwise XOR operator for an expiring vec4state.
+     * 
+     * Calculates the bitwise XOR of this vector and other vector (as in operator^), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator^=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+     * 
+     * @param other The vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator^(const vec4state& other) &&;
+
+    /**
+     * @brief Bitwise XOR operator for vec4state with an expiring vector.
+     * 
+     * Calculates the bitwise XOR of this vector and other vector (as in operator^), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator^(vec4state&& other) const&;
+
+    /**
+     * @brief Bitwise XOR operator for two expiring vec4state vectors.
+     * 
+     * Calculates the bitwise XOR of this vector and other vector (as in operator^), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator^(vec4state&& other) &&;
 
     /**
      * @brief Bitwise XOR operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then calculates the bitwise XOR of a bit in this vector with the corresponding bit in num, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method calculates the bitwise AND between each vector and the bitwise NOT of the other vector, then calculates the bitwise OR of the two results.
+     * Creates a vec4state that holds the value of num, then calculates the bitwise XOR of a bit in this vector with the corresponding bit in num, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. If the two bits are not equal, the result bit is 1. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to perform the bitwise XOR operation with.
@@ -239,19 +640,52 @@ public:
         return *this ^ vec4state(num);
     }
 
+    /**
+     * @brief Bitwise XNOR operator for vec4state.
+     * 
+     * Calculates the bitwise XNOR (~^ in SystemVerilog) of a bit in this vector with the corresponding bit in the other vector, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 1. If the two bits are not equal, the result bit is 0. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
+     * 
+     * @param other The vector to perform the bitwise XNOR operation with.
+     * @return A new vector that holds the result of the bitwise XNOR operation.
+     */
+    vec4state xnor(const vec4state& other) const;
+
+    /**
+     * @brief Bitwise XNOR operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the bitwise XNOR (~^ in SystemVerilog) of a bit in this vector with the corresponding bit in num, resulting in one bit for each bit of the vectors. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 1. If the two bits are not equal, the result bit is 0. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates once over the limbs of both vectors (using bitwiseXorXnor).
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to perform the bitwise XNOR operation with.
+     * @return A new vector that holds the result of the bitwise XNOR operation.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state xnor(T num) const {
+        return xnor(vec4state(num));
+    }
+
     /**
      * @brief Bitwise NOT operator for vec4state.
      * 
-     * Calculates the bitwise NOT of each bit in the vector, resulting in one bit for each bit of the vector. If the bit is 0, the result bit is 1. If the bit is 1, the result bit is 0. If the bit is unknown, the result bit is x. The method iterates over the vector's VPIs, and sets each bit in the aval to 1 only if the corresponding bit in the original vector is 0 (in any other case, the bit is set to 0, which means it can be either 0 or x). The bval stays the same (which means every known bit stays known and every unknown bit can be only x). Then the method zeroes down the bits that are out of range (because they have been set to 1 in the bitwise NOT).
+     * Calculates the bitwise NOT of each bit in the vector, resulting in one bit for each bit of the vector. If the bit is 0, the result bit is 1. If the bit is 1, the result bit is 0. If the bit is unknown, the result bit is x. The method iterates over the vector's limbs, and sets each bit in the aval to 1 only if the corresponding bit in the original vector is 0 (in any other case, the bit is set to 0, which means it can be either 0 or x). The bval stays the same (which means every known bit stays known and every unknown bit can be only x). Then the method zeroes down the bits that are out of range (because they have been set to 1 in the bitwise NOT).
      * 
      * @return A new vector that holds the result of the bitwise NOT operation.
      */
-    vec4state operator~() const;
+    vec4state operator~() const&;
+
+    /**
+     * @brief Bitwise NOT operator for an expiring vec4state.
+     * 
+     * Calculates the bitwise NOT of each bit in the vector (as in operator~), where this vector is a temporary that is not used after the operation. The result is calculated in place in the limbs of this vector and this vector is moved into the result, so no memory is allocated.
+     * 
+     * @return A vector that holds the result of the bitwise NOT operation.
+     */
+    vec4state operator~() &&;
 
     /**
      * @brief Logical equality operator for vec4state.
      * 
-     * Compares this vector to other vector bit for bit. This is done by calculating the bitwise XOR of the two vectors, and then checking if the result vector is zero. If the result vector holds at least one 1 bit, the vectors are not equal. If the result vector has unknown bits, the comparison is ambiguous and the method returns x. In any other case, if the result vector is only 0's, the vectors are equal.
+     * Compares this vector to other vector bit for bit (using logicalEquality), without building a temporary vector. If the vectors hold at least one known bit that is different, the vectors are not equal. Otherwise, if one of the vectors has unknown bits, the comparison is ambiguous and the method returns x. In any other case, the vectors are equal.
      * 
      * @param other The vector to compare to.
      * @return 1'b0 if the comparison fails.
@@ -263,7 +697,7 @@ public:
     /**
      * @brief Logical equality operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then compares this vector to num bit for bit. This is done by calculating the bitwise XOR of the two vectors, and then checking if the result vector is zero. If the result vector holds at least one 1 bit, the vectors are not equal. If the result vector has unknown bits, the comparison is ambiguous and the method returns x. In any other case, if the result vector is only 0's, the vectors are equal.
+     * Creates a vec4state that holds the value of num, then compares this vector to num bit for bit (using logicalEquality). If the vectors hold at least one known bit that is different, the vectors are not equal. Otherwise, if one of the vectors has unknown bits, the comparison is ambiguous and the method returns x. In any other case, the vectors are equal.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to compare to.
@@ -279,7 +713,7 @@ public:
     /**
      * @brief Logical inequality operator for vec4state.
      * 
-     * Compares this vector to other vector bit for bit. This is done by checking if the vectors are equal using the logical equality operator, and then negating the result.
+     * Compares this vector to other vector bit for bit (using logicalEquality), and then negates the result.
      * 
      * @param other The vector to compare to.
      * @return 1'b1 if the comparison fails.
@@ -291,7 +725,7 @@ public:
     /**
      * @brief Logical inequality operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then compares this vector to num bit for bit. This is done by checking if the vectors are equal using the logical equality operator, and then negating the result.
+     * Creates a vec4state that holds the value of num, then compares this vector to num bit for bit (using logicalEquality), and then negates the result.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to compare to.
@@ -307,7 +741,7 @@ public:
     /**
      * @brief Case equality operator for vec4state.
      * 
-     * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' VPIs, and checks if the aval and bval of each VPI are equal. If at least one of the VPIs is not equal, the vectors are not equal. If all of the VPIs are equal, the vectors are equal.
+     * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' limbs, and checks if the aval and bval of each limb are equal. If at least one of the limbs is not equal, the vectors are not equal. If all of the limbs are equal, the vectors are equal.
      * 
      * @param other The vector to compare to.
      * @return 1'b0 if the comparison fails.
@@ -318,7 +752,7 @@ public:
     /**
      * @brief Case equality operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' VPIs, and checks if the aval and bval of each VPI are equal. If at least one of the VPIs is not equal, the vectors are not equal. If all of the VPIs are equal, the vectors are equal.
+     * Creates a vec4state that holds the value of num, then compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal. If the vectors are of different lengths, the shorter vector is zero-extended to the size of the longer vector. The method iterates over the vectors' limbs, and checks if the aval and bval of each limb are equal. If at least one of the limbs is not equal, the vectors are not equal. If all of the limbs are equal, the vectors are equal.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to compare to.
@@ -364,7 +798,17 @@ public:
      * @param other The vector that holds the number of bit positions to shift by.
      * @return A new vector that holds the result of the logical shift left operation. If other vector holds unknown bits, then the result is only x's.
      */
-    vec4state operator<<(const vec4state& other);
+    vec4state operator<<(const vec4state& other) const&;
+
+    /**
+     * @brief Logical shift left operator for an expiring vec4state.
+     * 
+     * Shifts this vector to the left by the number of bit positions given by other vector (as in operator<<), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator<<=) and moved into the result, so no memory is allocated.
+     * 
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A vector that holds the result of the logical shift left operation. If other vector holds unknown bits, then the result is only x's.
+     */
+    vec4state operator<<(const vec4state& other) &&;
 
     /**
      * @brief Logical shift left operator for vec4state.
@@ -374,7 +818,17 @@ public:
      * @param num The number of bit positions to shift by.
      * @return A new vector that holds the result of the logical shift left operation.
      */
-    vec4state operator<<(const long long num);
+    vec4state operator<<(const long long num) const&;
+
+    /**
+     * @brief Logical shift left operator for an expiring vec4state.
+     * 
+     * Shifts this vector to the left by num bit positions (as in operator<<), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator<<=) and moved into the result, so no memory is allocated.
+     * 
+     * @param num The number of bit positions to shift by.
+     * @return A vector that holds the result of the logical shift left operation.
+     */
+    vec4state operator<<(const long long num) &&;
 
     /**
      * @brief Logical shift right operator for vec4state.
@@ -384,7 +838,17 @@ public:
      * @param other The vector that holds the number of bit positions to shift by.
      * @return A new vector that holds the result of the logical shift right operation. If other vector holds unknown bits, then the result is only x's.
      */
-    vec4state operator>>(const vec4state& other);
+    vec4state operator>>(const vec4state& other) const&;
+
+    /**
+     * @brief Logical shift right operator for an expiring vec4state.
+     * 
+     * Shifts this vector to the right by the number of bit positions given by other vector (as in operator>>), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator>>=) and moved into the result, so no memory is allocated.
+     * 
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A vector that holds the result of the logical shift right operation. If other vector holds unknown bits, then the result is only x's.
+     */
+    vec4state operator>>(const vec4state& other) &&;
 
     /**
      * @brief Logical shift left operator for vec4state.
@@ -394,12 +858,182 @@ public:
      * @param num The number of bit positions to shift by.
      * @return A new vector that holds the result of the logical shift right operation.
      */
-    vec4state operator>>(const long long num);
+    vec4state operator>>(const long long num) const&;
+
+    /**
+     * @brief Logical shift right operator for an expiring vec4state.
+     * 
+     * Shifts this vector to the right by num bit positions (as in operator>>), where this vector is a temporary that is not used after the operation. The vector is shifted in place (using operator>>=) and moved into the result, so no memory is allocated.
+     * 
+     * @param num The number of bit positions to shift by.
+     * @return A vector that holds the result of the logical shift right operation.
+     */
+    vec4state operator>>(const long long num) &&;
+
+    /**
+     * @brief Bitwise AND assignment operator for vec4state.
+     * 
+     * Calculates the bitwise AND of this vector and other vector (as in operator&) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @param other The vector to perform the bitwise AND operation with.
+     * @return A reference to this vector.
+     */
+    vec4state& operator&=(const vec4state& other);
+
+    /**
+     * @brief Bitwise AND assignment operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the bitwise AND of this vector and num (as in operator&) and stores the result in this vector. The result keeps the number of bits of this vector: if num is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to perform the bitwise AND operation with.
+     * @return A reference to this vector.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state& operator&=(T num) {
+        return *this &= vec4state(num);
+    }
+
+    /**
+     * @brief Bitwise OR assignment operator for vec4state.
+     * 
+     * Calculates the bitwise OR of this vector and other vector (as in operator|) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @param other The vector to perform the bitwise OR operation with.
+     * @return A reference to this vector.
+     */
+    vec4state& operator|=(const vec4state& other);
+
+    /**
+     * @brief Bitwise OR assignment operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the bitwise OR of this vector and num (as in operator|) and stores the result in this vector. The result keeps the number of bits of this vector: if num is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to perform the bitwise OR operation with.
+     * @return A reference to this vector.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state& operator|=(T num) {
+        return *this |= vec4state(num);
+    }
+
+    /**
+     * @brief Bitwise XOR assignment operator for vec4state.
+     * 
+     * Calculates the bitwise XOR of this vector and other vector (as in operator^) and stores the result in this vector. The result keeps the number of bits of this vector: if other vector is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @param other The vector to perform the bitwise XOR operation with.
+     * @return A reference to this vector.
+     */
+    vec4state& operator^=(const vec4state& other);
+
+    /**
+     * @brief Bitwise XOR assignment operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the bitwise XOR of this vector and num (as in operator^) and stores the result in this vector. The result keeps the number of bits of this vector: if num is shorter it is zero-extended, and if it is longer its bits that are out of range of this vector are ignored. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector.
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to perform the bitwise XOR operation with.
+     * @return A reference to this vector.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state& operator^=(T num) {
+        return *this ^= vec4state(num);
+    }
+
+    /**
+     * @brief Addition assignment operator for vec4state.
+     * 
+     * Calculates the sum of this vector and other vector (as in operator+) and stores the result in this vector. The result keeps the number of bits of this vector, so the carry out of the most significant bit is discarded. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
+     * 
+     * @param other The vector to add.
+     * @return A reference to this vector.
+     */
+    vec4state& operator+=(const vec4state& other);
+
+    /**
+     * @brief Addition assignment operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the sum of this vector and num (as in operator+) and stores the result in this vector. The result keeps the number of bits of this vector, so the carry out of the most significant bit is discarded. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to add.
+     * @return A reference to this vector.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state& operator+=(T num) {
+        return *this += vec4state(num);
+    }
+
+    /**
+     * @brief Subtraction assignment operator for vec4state.
+     * 
+     * Calculates the difference between this vector and other vector (as in operator-) and stores the result in this vector. The result keeps the number of bits of this vector, and a negative result is represented in two's complement. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
+     * 
+     * @param other The vector to subtract.
+     * @return A reference to this vector.
+     */
+    vec4state& operator-=(const vec4state& other);
+
+    /**
+     * @brief Subtraction assignment operator for vec4state.
+     * 
+     * Creates a vec4state that holds the value of num, then calculates the difference between this vector and num (as in operator-) and stores the result in this vector. The result keeps the number of bits of this vector, and a negative result is represented in two's complement. The limbs of this vector are updated in place, so no memory is allocated unless the planes are shared with another vector. If one of the vectors holds unknown bits, this vector is set to x's.
+     * 
+     * @tparam The type of num, must be an integral type or a string.
+     * @param num The value to subtract.
+     * @return A reference to this vector.
+     */
+    template<typename T, typename enable_if<is_valid_type_for_vec4state<T>::value, bool>::type = true>
+    vec4state& operator-=(T num) {
+        return *this -= vec4state(num);
+    }
+
+    /**
+     * @brief Logical shift left assignment operator for vec4state.
+     * 
+     * Extracts the value stored in other vector, then shifts this vector in place to the left by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, this vector is set to 0's. If other vector holds unknown bits, this vector is set to x's.
+     * 
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A reference to this vector.
+     */
+    vec4state& operator<<=(const vec4state& other);
+
+    /**
+     * @brief Logical shift left assignment operator for vec4state.
+     * 
+     * Shifts this vector in place to the left by the number of bit positions given by num. The limbs are moved from the most significant limb down, so no temporary vector is needed. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in the vector, this vector is set to 0's.
+     * 
+     * @param num The number of bit positions to shift by.
+     * @return A reference to this vector.
+     */
+    vec4state& operator<<=(const long long num);
+
+    /**
+     * @brief Logical shift right assignment operator for vec4state.
+     * 
+     * Extracts the value stored in other vector, then shifts this vector in place to the right by the number of bit positions given by other vector. The vacated bit positions are filled with zeros. If other vector holds a value that cannot be an index of a bit position in this vector, this vector is set to 0's. If other vector holds unknown bits, this vector is set to x's.
+     * 
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A reference to this vector.
+     */
+    vec4state& operator>>=(const vec4state& other);
+
+    /**
+     * @brief Logical shift right assignment operator for vec4state.
+     * 
+     * Shifts this vector in place to the right by the number of bit positions given by num. The limbs are moved from the least significant limb up, so no temporary vector is needed. The vacated bit positions are filled with zeros. If num is negative or not less than the number of bits in the vector, this vector is set to 0's.
+     * 
+     * @param num The number of bit positions to shift by.
+     * @return A reference to this vector.
+     */
+    vec4state& operator>>=(const long long num);
 
     /**
      * @brief Get bit select operator for vec4state.
      * 
-     * Extracts the bit stored in this vector at the given index by extracting the value stored in index and by using the getPartSelect method by setting the start and end indices to index.
+     * Extracts the bit stored in this vector at the given index by decoding index with tryToUint64 and by reading the bit with getBit.
      * 
      * @param index The index of the bit to extract.
      * @return The value of the bit at index index in this vector. If the index holds unknown values or is out of range, the result is a vector of x's.
@@ -409,7 +1043,7 @@ public:
     /**
      * @brief Get bit select operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of index, then extracts the bit stored in this vector at the given index. Uses the getPartSelect method by setting the start and end indices to index.
+     * Creates a vec4state that holds the value of index, then extracts the bit stored in this vector at the given index. Uses the getBitSelect method that takes a vector index.
      * 
      * @tparam The type of index, must be an integral type or a string.
      * @param index The index of the bit to extract.
@@ -472,10 +1106,30 @@ public:
         setBitSelect(vec4state(index), vec4state(newValue));
     }
 
+    /**
+     * @brief Reads a single bit of the vector.
+     * 
+     * Loads the limb of each plane that holds the bit and masks the bit out of it, so reading a bit takes constant time and doesn't allocate memory (unlike getBitSelect, which decodes an index vector and returns a vector).
+     * 
+     * @param index The index of the bit to read.
+     * @return The value of the bit at index index, or x if the index is out of range.
+     */
+    logic getBit(long long index) const;
+
+    /**
+     * @brief Writes a single bit of the vector.
+     * 
+     * Stores the bit into the limb of each plane that holds it with a mask, so writing a bit takes constant time and doesn't allocate memory, unless the planes are shared with another vector. The unknown flag is updated from the bit, and the vector is scanned for unknown bits only when an x or z bit is overwritten with a 0 or a 1. If the index is out of range, the vector remains unchanged. If bit is not a BitValue, vec4stateExceptionInvalidInput is thrown.
+     * 
+     * @param index The index of the bit to write.
+     * @param bit The value to write.
+     */
+    void setBit(long long index, BitValue bit);
+
     /**
      * @brief Get part select operator for vec4state.
      * 
-     * Extracts the part of this vector from index start to index end. If the start index is greater than the end index, vec4stateExceptionInvalidRange is thrown. If the slice is out of range, the out of range bits are set to x. This is done by shifting this vector's bit until reaching the desired bits, then extracting the relevant bits from the vector. If the part is out of range, the out of range bits are set to x.
+     * Extracts the part of this vector from index start to index end. If the start index is greater than the end index, vec4stateExceptionInvalidRange is thrown. If the slice is out of range, the out of range bits are set to x. Each limb of the result is funnel-shifted out of the (at most two) limbs of this vector that hold its bits, so only the limbs of the slice are read and the cost is proportional to the width of the slice, not to the size of this vector.
      * 
      * @param end The end index of the part to extract.
      * @param start The start index of the part to extract.
@@ -486,13 +1140,13 @@ public:
     /**
      * @brief Set part select operator for vec4state.
      * 
-     * Sets the part of the vector starting from the start index and ending at end index, to the value stored in other vector. If the end index is less than the start index, vec4stateExceptionInvalidRange is thrown. This is done by zeroing down the bits between the start and the end indices and inserting the bits of other vector into the slice. If the slice is completely out of range, the vector remains unchanged. If only start or end are out of range, the slice is truncated to the valid range.
+     * Sets the part of the vector starting from the start index and ending at end index, to the value stored in other vector. If the end index is less than the start index, vec4stateExceptionInvalidRange is thrown. Other is truncated or zero-extended to the size of the slice, and its bits are written into the limbs of the slice in place, where only the first and last limbs of the slice keep some of their old bits. If the slice is completely out of range, the vector remains unchanged. If only start or end are out of range, the slice is truncated to the valid range. The cost is proportional to the width of the slice, unless the slice overwrites unknown bits with known bits, which requires checking the rest of the vector for unknown bits.
      * 
      * @param end The end index of the part to set.
      * @param start The start index of the part to set.
      * @param other The vector to set the part to.
      */
-    void setPartSelect(long long end, long long start, vec4state other);
+    void setPartSelect(long long end, long long start, const vec4state& other);
 
     /**
      * @brief Set part select operator for vec4state.
@@ -568,7 +1222,7 @@ public:
     /**
      * @brief Logical NOT operator for vec4state.
      * 
-     * Checks if this vector is true (holds at least one 1 bit). This is done by iterating over the vector's VPIs, and checking if at least one of the VPIs has a bit set to 1.
+     * Checks if this vector is true (holds at least one 1 bit). This is done by iterating over the vector's limbs, and checking if at least one of the limbs has a bit set to 1.
      * 
      * @return 1'b0 if the vector is true.
      * @return 1'b1 if the vector is false.
@@ -691,17 +1345,47 @@ public:
     /**
      * @brief Addition operator for vec4state.
      * 
-     * Calculates the sum of this vector and other vector. The method iterates over the vectors' VPIs, and calculates the sum of the corresponding VPIs. If the sum is greater than 32 bits, the carry is set to 1 for the next iteration. If there is a carry in the last iteration, the size of the result vector is increased by 1.
+     * Calculates the sum of this vector and other vector. The method iterates over the vectors' limbs, and adds the corresponding limbs together with the carry of the previous limbs (using addWithCarry). If the sum has a carry out of the most significant bit, the size of the result vector is increased by 1.
      * 
      * @param other The vector to add.
      * @return A new vector that holds the result of the addition operation. If one of the vectors holds unknown bits, then the result is only x's.
      */
-    vec4state operator+(const vec4state& other) const;
+    vec4state operator+(const vec4state& other) const&;
+
+    /**
+     * @brief Addition operator for an expiring vec4state.
+     * 
+     * Calculates the sum of this vector and other vector (as in operator+), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator+=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector. If the sum has a carry out of the most significant bit, the size of the result vector is increased by 1.
+     * 
+     * @param other The vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator+(const vec4state& other) &&;
+
+    /**
+     * @brief Addition operator for vec4state with an expiring vector.
+     * 
+     * Calculates the sum of this vector and other vector (as in operator+), where other vector is a temporary that is not used after the operation. The operation is commutative, so the result is calculated in the limbs of other vector if it is at least as wide as this vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator+(vec4state&& other) const&;
+
+    /**
+     * @brief Addition operator for two expiring vec4state vectors.
+     * 
+     * Calculates the sum of this vector and other vector (as in operator+), where both vectors are temporaries that are not used after the operation. The result is calculated in the limbs of the wider vector (see the overload for an expiring vec4state).
+     * 
+     * @param other The expiring vector to perform the operation with.
+     * @return A vector that holds the result of the operation.
+     */
+    vec4state operator+(vec4state&& other) &&;
 
     /**
      * @brief Addition operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then calculates the sum of this vector and num. The method iterates over the vectors' VPIs, and calculates the sum of the corresponding VPIs. If the sum is greater than 32 bits, the carry is set to 1 for the next iteration. If there is a carry in the last iteration, the size of the result vector is increased by 1.
+     * Creates a vec4state that holds the value of num, then calculates the sum of this vector and num. The method iterates over the vectors' limbs, and adds the corresponding limbs together with the carry of the previous limbs (using addWithCarry). If the sum has a carry out of the most significant bit, the size of the result vector is increased by 1.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to add.
@@ -715,17 +1399,27 @@ public:
     /**
      * @brief Subtraction operator for vec4state.
      * 
-     * Calculates the difference between this vector and other vector. The method iterates over the vectors' VPIs, and calculates the difference of the corresponding VPIs. If the current VPI in this vector is less than the corresponding one in other vector, the method borrows from the next positive VPI of this vector. If there is no VPI to borrow from, the result is negative.
+     * Calculates the difference between this vector and other vector. The method iterates over the vectors' limbs, and subtracts the corresponding limbs together with the borrow of the previous limbs (using subWithBorrow). If this vector is less than other vector, the result is negative and is represented in two's complement.
      * 
      * @param other The vector to subtract.
      * @return A new vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
      */
-    vec4state operator-(const vec4state& other) const;
+    vec4state operator-(const vec4state& other) const&;
+
+    /**
+     * @brief Subtraction operator for an expiring vec4state.
+     * 
+     * Calculates the difference between this vector and other vector (as in operator-), where this vector is a temporary that is not used after the operation. If this vector is at least as wide as other vector, the result is calculated in place in the limbs of this vector (using operator-=) and this vector is moved into the result, so no memory is allocated. Otherwise, the result is calculated into a new vector.
+     * 
+     * @param other The vector to subtract.
+     * @return A vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    vec4state operator-(const vec4state& other) &&;
 
     /**
      * @brief Subtraction operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then calculates the difference between this vector and num.  The method iterates over the vectors' VPIs, and calculates the difference of the corresponding VPIs. If the current VPI in this vector is less than the corresponding one in other vector, the method borrows from the next positive VPI of this vector. If there is no VPI to borrow from, the result is negative.
+     * Creates a vec4state that holds the value of num, then calculates the difference between this vector and num.  The method iterates over the vectors' limbs, and subtracts the corresponding limbs together with the borrow of the previous limbs (using subWithBorrow). If this vector is less than other vector, the result is negative and is represented in two's complement.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to subtract.
@@ -739,7 +1433,7 @@ public:
     /**
      * @brief Multiplication operator for vec4state.
      * 
-     * Calculates the product of this vector and other vector. The method aligns the vectors to the same size, and then multiplies each VPI in this vector by each VPI in other vector and adds the result to the corresponding VPI in the result vector.
+     * Calculates the product of this vector and other vector. The product is calculated into the result vector (using v4::mul), by Comba multiplication of the limbs, or by Karatsuba multiplication if the vectors are wide. The product is truncated to the number of bits of the longer vector.
      * 
      * @param other The vector to multiply.
      * @return A new vector that holds the result of the multiplication operation. If one of the vectors holds unknown bits, then the result is only x's.
@@ -749,7 +1443,7 @@ public:
     /**
      * @brief Multiplication operator for vec4state.
      * 
-     * Creates a vec4state that holds the value of num, then calculates the product of this vector and num. The method aligns the vectors to the same size, and then multiplies each VPI in this vector by each VPI in other vector and adds the result to the corresponding VPI in the 
+     * Creates a vec4state that holds the value of num, then calculates the product of this vector and num (as in the vec4state overload of operator*). The product is truncated to the number of bits of the longer vector.
      * 
      * @tparam The type of num, must be an integral type or a string.
      * @param num The value to multiply.
@@ -763,7 +1457,7 @@ public:
     /**
      * @brief Division operator for vec4state.
      * 
-     * Calculates the division of this vector by other vector. If other is 0, vec4stateExceptionInvalidOperation is thrown.
+     * Calculates the division of this vector by other vector (using v4::divmod). If other is 0, vec4stateExceptionInvalidOperation is thrown.
      * 
      * @param other The vector to divide by.
      * @return A new vector that holds the result of the division operation. If one of the vectors holds unknown bits, then the result is only x's.
@@ -787,7 +1481,7 @@ public:
     /**
      * @brief Modulus operator for vec4state.
      * 
-     * Calculates the modulus of this vector by other vector. If other is 0, vec4stateExceptionInvalidOperation is thrown.
+     * Calculates the modulus of this vector by other vector (using v4::divmod). If other is 0, vec4stateExceptionInvalidOperation is thrown.
      * 
      * @param other The vector to calculate the modulus by.
      * @return A new vector that holds the result of the modulus operation. If one of the vectors holds unknown bits, then the result is only x's.
@@ -841,10 +1535,19 @@ public:
         return power(vec4state(num));
     }
 
+    /**
+     * @brief Fills the vector with a single bit.
+     * 
+     * Sets every bit of the vector to bit (that can be either 0, 1, x, or z), keeping the number of bits of the vector. The aval and bval planes are set with memset and only the last limb is masked. The limbs are overwritten in place, and if the planes are shared with another vector, a new block is allocated for this vector without copying the shared limbs. If bit is not a BitValue, vec4stateExceptionInvalidInput is thrown and the vector is left unchanged.
+     * 
+     * @param bit The bit to fill the vector with.
+     */
+    void fill(BitValue bit);
+
     /**
      * @brief Conversion operator to vec2state for vec4state.
      * 
-     * Converts this vector to a 2-state vector by replacing all the unknown values with 0's. This is done by iterating over the vector's VPIs, setting the z bits to x bits (aval = 0, bval = 1), and then setting the x bits to 0 bits.
+     * Converts this vector to a 2-state vector by replacing all the unknown values with 0's. This is done by iterating over the vector's limbs, setting the z bits to x bits (aval = 0, bval = 1), and then setting the x bits to 0 bits.
      */
     void convertTo2State();
     
@@ -858,10 +1561,30 @@ public:
     /**
      * @brief Gets the vector of the VPI elements in this vector.
      * 
+     * The values are stored in separate aval and bval planes of limbs, so this method materializes a new array of 32-bit VPI elements from the planes. Changes to the returned array do not affect this vector. If the vector has been moved from, nullptr is returned.
+     * 
      * @return The vector of the VPI elements in this vector.
      */
     shared_ptr<VPI[]> getVector() const;
 
+    /**
+     * @brief Gets the aval plane of this vector.
+     * 
+     * The aval plane holds the aval limbs of the vector contiguously, starting from the least significant limb. On the heap, the plane is aligned to PLANE_ALIGNMENT bytes.
+     * 
+     * @return A pointer to the first of getNumLimbs() aval limbs.
+     */
+    const limb_t* getAvalPlane() const;
+
+    /**
+     * @brief Gets the bval plane of this vector.
+     * 
+     * The bval plane holds the bval limbs of the vector contiguously, starting from the least significant limb. On the heap, the plane is aligned to PLANE_ALIGNMENT bytes.
+     * 
+     * @return A pointer to the first of getNumLimbs() bval limbs.
+     */
+    const limb_t* getBvalPlane() const;
+
     /**
      * @brief Gets the number of VPI elements in this vector.
      * 
@@ -869,6 +1592,13 @@ public:
      */
     long long getVectorSize() const;
 
+    /**
+     * @brief Gets the number of limbs in each plane of this vector.
+     * 
+     * @return The number of limbs in each plane of this vector.
+     */
+    long long getNumLimbs() const;
+
     /**
      * @brief Checks if the vector contains any unknown values.
      * 
@@ -877,22 +1607,101 @@ public:
      */
     bool isUnknown() const;
 
+    /**
+     * @brief Converts the vector to a 64-bit number without throwing exceptions.
+     * 
+     * Calculates the numerical value that the vector holds by combining its first 64 bits. If the vector has 1's after the 64th bit, NUMBER_TOO_LARGE is returned (even if it also has unknown bits). Otherwise, if the vector has unknown bits, NUMBER_UNKNOWN is returned. In both cases value is not changed. This is the decoder of shift amounts and bit indices, where an unknown or too large number is a normal case and not an error.
+     * 
+     * @param value The variable to write the number into.
+     * @return NUMBER_OK if the number was written into value, otherwise the reason that the vector can't be converted.
+     */
+    NumberStatus tryToUint64(uint64_t& value) const;
+
     /**
      * @brief String representation of the vector.
      * 
-     * Creates a string representation of the vecor, where each bit is represented by it's corresponding BitValue (0, 1, x, or z). This is done by iterating over the vector's VPIs from MSB to LSB, and for each VPI, iterating over the bits in it and adding the corresponding BitValue to the result string.
+     * Creates a string representation of the vecor, where each bit is represented by it's corresponding BitValue (0, 1, x, or z). The string is allocated once with the size of the vector and filled by toChars.
      * 
      * @return A string representation of the vector.
      */
     string toString() const;
 
+    /**
+     * @brief String representation of the vector in a radix.
+     * 
+     * Creates a string representation of the vector in binary (as in toString()), octal, decimal or hexadecimal, like the %b, %o, %d and %h formats of SystemVerilog $display. Octal and hexadecimal digits are calculated directly from the aval and bval bits of each digit (using toPowerOfTwoRadixString), and the decimal digits are calculated by divide-and-conquer base conversion (using toDecimalString). If radix is not 2, 8, 10 or 16, vec4stateExceptionInvalidInput is thrown.
+     * 
+     * @param radix The radix to represent the vector in.
+     * @return A string representation of the vector in radix.
+     */
+    string toString(int radix) const;
+
+    /**
+     * @brief Writes the string representation of the vector into a buffer.
+     * 
+     * Writes the BitValues of the vector (0, 1, x, or z) from the MSB to the LSB into buf, in the style of std::to_chars: the characters are not null-terminated and no memory is allocated. Every 8 bits are translated to 8 characters at once, using a lookup table that spreads each bit of a byte of the aval and bval planes into a byte of a word, and calculating the characters of the word with a few additions.
+     * 
+     * @param buf The buffer to write into.
+     * @param len The size of the buffer, must be at least the number of bits in the vector.
+     * @return A to_chars_result whose ptr points one past the last written character. If len is less than the number of bits in the vector, ec is errc::value_too_large, ptr is buf + len and the contents of the buffer are unspecified.
+     */
+    to_chars_result toChars(char* buf, size_t len) const;
+
 private:
+    template <long long N>
+    friend class vec4state_fixed;
+
+    template <typename Expr>
+    friend class vec4state_expr;
+
+    friend void v4::band(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::bor(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::bxor(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::bxnor(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::bnot(vec4state& dst, const vec4state& first);
+    friend void v4::add(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::sub(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::mul(vec4state& dst, const vec4state& first, const vec4state& second);
+    friend void v4::addWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits);
+    friend void v4::mulWrap(vec4state& dst, const vec4state& first, const vec4state& second, long long numBits);
+    friend void v4::divmod(vec4state& quotient, vec4state& remainder, const vec4state& first, const vec4state& second);
+    friend void v4::shl(vec4state& dst, const vec4state& first, long long num);
+    friend void v4::shr(vec4state& dst, const vec4state& first, long long num);
+
     /**
-     * @brief Array of VPI elements.
+     * @brief The aval plane of the vector.
      * 
-     * The 4-value vector consists of an array of VPI elements, where each element is 32 bits long and each bit can be either 0, 1, x, or z. The first element holds the least significant 32 bits.
+     * Holds the aval limb of each BITS_IN_LIMB bits of the vector contiguously, where the first limb holds the least significant bits. Points to inlineAval if the vector holds up to INLINE_NUM_LIMBS limbs, and into the block owned by heapPlanes otherwise.
      */
-    shared_ptr<VPI[]> vector;
+    limb_t* aval;
+
+    /**
+     * @brief The bval plane of the vector.
+     * 
+     * Holds the bval limb of each BITS_IN_LIMB bits of the vector contiguously, where the first limb holds the least significant bits. Points to inlineBval if the vector holds up to INLINE_NUM_LIMBS limbs, and into the block owned by heapPlanes otherwise.
+     */
+    limb_t* bval;
+
+    /**
+     * @brief Inline storage of the aval plane for small vectors.
+     * 
+     * Holds the aval limbs of vectors that have up to INLINE_NUM_LIMBS limbs, so that small vectors (like the 1-bit results of the relational operators) do not allocate memory on the heap.
+     */
+    limb_t inlineAval[INLINE_NUM_LIMBS];
+
+    /**
+     * @brief Inline storage of the bval plane for small vectors.
+     * 
+     * Holds the bval limbs of vectors that have up to INLINE_NUM_LIMBS limbs.
+     */
+    limb_t inlineBval[INLINE_NUM_LIMBS];
+
+    /**
+     * @brief Heap storage of the planes for big vectors.
+     * 
+     * Owns a single PLANE_ALIGNMENT aligned block that holds the aval plane followed by the bval plane, each padded to a multiple of PLANE_ALIGNMENT bytes. Empty if the planes are stored inline. The block is shared between copies of the vector until one of them is changed (see makeUnique).
+     */
+    shared_ptr<limb_t> heapPlanes;
 
     /**
      * @brief Number of bits in the vector.
@@ -902,11 +1711,18 @@ private:
     long long numBits;
 
     /**
-     * @brief Number of VPI elements in the vector field.
+     * @brief Number of limbs in each plane of the vector.
+     * 
+     * The number of limbs is equal to the number of bits divided by BITS_IN_LIMB, rounded up.
+     */
+    long long numLimbs;
+
+    /**
+     * @brief Number of limbs reserved in each plane of the vector.
      * 
-     * The number of VPI elements in the vector is equal to the number of bits divided by 32, rounded up.
+     * INLINE_NUM_LIMBS if the planes are stored inline, otherwise the padded size of each plane in the heap block. The number of limbs of the vector can grow up to capacity without allocating memory (see reshape).
      */
-    long long vectorSize;
+    long long capacity;
 
     /**
      * @brief Flag that indicates if the vector contains any unknown values.
@@ -917,19 +1733,78 @@ private:
     bool unknown;
 
     /**
-     * @brief Single repeated BitValue constructor for vec4state.
+     * @brief Tag type for the constructor that leaves the limbs uninitialized.
+     */
+    enum NoInit { NO_INIT };
+
+    /**
+     * @brief Uninitialized constructor for vec4state.
      * 
-     * Initializes a vector with a single bit (that can be either 0, 1, x, or z) repeated numBits times. If numBits is non-positive or bit is not a BitValue, the vector is default initialized and vec4stateExceptionInvalidSize or vec4stateExceptionInvalidInput is thrown, respectively.
+     * Initializes a known vector of numBits bits without initializing its limbs. Used internally by operators that overwrite every limb of the result.
      * 
-     * @param bit The bit to repeat.
      * @param numBits The number of bits in the vector.
      */
-    vec4state(BitValue bit, long long numBits);
+    vec4state(long long numBits, NoInit);
+
+    /**
+     * @brief Allocates the storage of the aval and bval planes for vec4state.
+     * 
+     * Sets the number of limbs of the vector to newNumLimbs and points the planes to the inline storage if newNumLimbs is at most INLINE_NUM_LIMBS. Otherwise, allocates a single PLANE_ALIGNMENT aligned block on the heap that holds the aval plane followed by the bval plane. The values of the limbs are not initialized.
+     * 
+     * @param newNumLimbs The new number of limbs in each plane.
+     */
+    void allocateVector(long long newNumLimbs);
+
+    /**
+     * @brief Resizes the storage of the aval and bval planes for vec4state.
+     * 
+     * Changes the number of limbs in the planes to newNumLimbs, keeping the values of the limbs that are still in range and zero-extending the new limbs. If the planes are owned only by this vector and have enough capacity, the limbs stay in place. Otherwise, the limbs are moved to new storage.
+     * 
+     * @param newNumLimbs The new number of limbs in each plane.
+     */
+    void resizeVector(long long newNumLimbs);
+
+    /**
+     * @brief Reshapes the vector to hold the result of an operation.
+     * 
+     * Sets the number of bits in the vector to newNumBits and makes this vector the only owner of its planes, so that the limbs can be overwritten. The planes are reallocated only if they are shared with another vector or if the vector does not have enough capacity for newNumBits bits. If keepValues is true (when this vector is also an operand of the operation), the vector is zero-extended or truncated to newNumBits in place. Otherwise, the values of the limbs are not initialized.
+     * 
+     * @param newNumBits The new number of bits in the vector.
+     * @param keepValues true to keep the values of the vector.
+     */
+    void reshape(long long newNumBits, bool keepValues);
+
+    /**
+     * @brief Copies a vector into this vector.
+     * 
+     * Makes this vector hold the same bits as other vector, including its number of bits (unlike the assignment operator, which keeps the number of bits of this vector). The limbs are copied into the planes of this vector, which are reallocated only if needed (see reshape).
+     * 
+     * @param other The vector to copy.
+     */
+    void copyFrom(const vec4state& other);
+
+    /**
+     * @brief Makes this vector the only owner of its planes.
+     * 
+     * Copies of a vector that is stored on the heap share its planes until one of them is changed. This method must be called before changing the limbs of the planes in place: if the planes are shared with another vector, they are cloned into a new block that only this vector owns. Inline planes are never shared, so they are left as is.
+     */
+    void makeUnique();
+
+    /**
+     * @brief Adds a vector to this vector in place.
+     * 
+     * Adds other vector to the limbs of this vector in a single carry chain (using addLimbs), where a limb that is out of range of other vector is 0 and the carry propagation stops once the carry is 0. The result keeps the number of bits of this vector. Both vectors must hold only known bits.
+     * 
+     * @param other The vector to add.
+     * @return true if the sum has a carry out of the most significant bit of this vector.
+     * @return false otherwise.
+     */
+    bool addInPlace(const vec4state& other);
 
     /**
      * @brief Increment number of bits for vec4state.
      * 
-     * Increments the number of bits in the vector to newNumBits by assigning a bigger VPI array to this vector, copying the values from the original array to the new one, and zero-extending the new VPIs in the new array. Throws vec4stateExceptionInvalidSize if newNumBits is less than the current number of bits or non-positive. If newNumBits is the same as the current number of bits, the vector remains unchanged.
+     * Increments the number of bits in the vector to newNumBits by assigning a bigger limb array to this vector, copying the values from the original array to the new one, and zero-extending the new limbs in the new array. Throws vec4stateExceptionInvalidSize if newNumBits is less than the current number of bits or non-positive. If newNumBits is the same as the current number of bits, the vector remains unchanged.
      * 
      * @param newNumBits The new number of bits in the vector.
      */
@@ -938,50 +1813,54 @@ private:
     /**
      * @brief Truncate number of bits for vec4state.
      * 
-     * Decreases the number of bits in the vector to newNumBits by assigning a smaller VPI array to this vector, copying the values that are in the new range from the original array to the new one, and truncating the VPI that are not in the new range. Throws vec4stateExceptionInvalidSize if newNumBits is greater than the current number of bits or negative. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is 0, the vector is truncated to a single x bit.
+     * Decreases the number of bits in the vector to newNumBits by assigning a smaller limb array to this vector, copying the values that are in the new range from the original array to the new one, and truncating the limbs that are not in the new range. Throws vec4stateExceptionInvalidSize if newNumBits is greater than the current number of bits or negative. If newNumBits is the same as the current number of bits, the vector remains unchanged. If newNumBits is 0, the vector is truncated to a single x bit.
      * 
      * @param newNumBits The new number of bits in the vector.
      */
     void decNumBits(long long newNumBits);
 
     /**
-     * @brief Extract number from vector for vec4state.
+     * @brief Bitwise XOR or XNOR of the vectors into a destination vector.
      * 
-     * Calculates the numerical value that the vector holds by iterating over the vector's VPIs, adding and shifting them. This method can be used only if the vector has up to 2 VPI elements (so it's value can be represented by 64 bits) and has no unknown bits. If the vector has more than 2 VPI elements, vec4stateExceptionInvalidSize is throwns. If the vector has unknown bits, vec4stateExceptionUnknownVector is thrown.
+     * Calculates the bitwise XOR (or XNOR, if isXnor is true) of first and second into dst in a single pass over their limbs. If at least one of the bits is unknown, the result bit is x. Otherwise, the result bit is the XOR (or XNOR) of the known bits. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. dst may be one of the vectors.
      * 
-     * @return The numerical value that the vector holds.
+     * @param dst The vector to write the result into.
+     * @param first The first vector.
+     * @param second The second vector.
+     * @param isXnor true to calculate the bitwise XNOR, false to calculate the bitwise XOR.
      */
-    long long extractNumberFromVector() const;
+    static void bitwiseXorXnor(vec4state& dst, const vec4state& first, const vec4state& second, bool isXnor);
 
     /**
-     * @brief Get part of the vector that is in range.
+     * @brief Octal or hexadecimal representation of the vector.
      * 
-     * Extracts the part of the vector that is in range, starting from the first bit and ending at the given end index. If the end index is out of range, vec4stateExceptionInvalidInput is thrown. This is done by initializing the result vector to end z bits, which means that it holds end 1 bits in it's aval and bval. Then, the method iterates over the vector's VPIs and copying the relevant bits to the result vector by performing a bitwise AND operation between the vector's VPIs and the result vector's VPIs.
+     * Creates a string of all the digits of the vector (with leading zeros), where each digit is made of bitsInDigit bits of the aval and bval planes, from the most significant digit. A digit that holds only known bits is written in lowercase, and a digit that holds unknown bits is written as x, z, X or Z (using unknownDigitChar). The most significant digit is made only of the bits that are in range.
      * 
-     * @param end The end index of the part to extract.
-     * @return The part of the vector from the first bit to the end index.
+     * @param bitsInDigit The number of bits in a digit, 3 for octal or 4 for hexadecimal.
+     * @return The digits of the vector.
      */
-    vec4state getPartValidRange(long long end) const;
+    string toPowerOfTwoRadixString(int bitsInDigit) const;
 
     /**
-     * @brief Addition of the aval and bval of the vectors.
+     * @brief Decimal representation of the vector.
      * 
-     * Adds the aval and bval of the vectors, resulting in a new vector. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector. The method iterates over the vectors' VPIs and calculates the sum of the aval and bval of each VPI.
+     * Creates a string of the unsigned decimal value of the vector, without leading zeros. The powers 10^(DECIMAL_DIGITS_IN_CHUNK * 2^k) that are needed for the vector are calculated by squaring (using multiplyLimbs), and the digits are written by divide-and-conquer base conversion (using writeDecimalDigits). If the vector holds unknown bits, the result is a single x, z, X or Z (using unknownDigitChar).
      * 
-     * @param other The vector to add to this vector.
-     * @return A new vector that holds the result of the addition.
+     * @return The decimal digits of the vector.
      */
-    vec4state additionAvalBval(const vec4state& other) const;
+    string toDecimalString() const;
 
     /**
-     * @brief Bitwise AND of the aval and bval of the vectors.
+     * @brief Logical equality of the vectors.
      * 
-     * Calculates the bitwise AND of the aval and bval of the vectors. The method iterates over the vectors' VPIs and calculates the bitwise AND of the aval and bval of each VPI. If the vectors are of unequal bit lengths, the smaller vector is zero-extended to the size of the larger vector.
+     * Compares this vector to other vector bit for bit in a single pass over their limbs, where the limbs that are out of range of the shorter vector are 0. The method stops at the first limb that holds a known bit that is different in the two vectors, so the cost depends on the position of the first difference rather than on the size of the vectors.
      * 
-     * @param other The vector to perform the bitwise AND operation with.
-     * @return A new vector that holds the result of the bitwise AND operation.
+     * @param other The vector to compare to.
+     * @return ZERO if the vectors hold a known bit that is different.
+     * @return ONE if the vectors are equal.
+     * @return X if the comparison is ambiguous (due to unknown bits in one of the vectors).
      */
-    vec4state bitwiseAndAvalBval(const vec4state& other) const;
+    BitValue logicalEquality(const vec4state& other) const;
 
     /**
      * @brief Sets the number of bits to a new number for vec4state.
@@ -0,0 +1,500 @@
+/**
+ * @file vec4stateExpr.h
+ * @brief Declaration and implementation of the expression templates for lazy bitwise expressions over vec4state.
+ *
+ * This file contains the vec4state_expr class template and its nodes, which represent a tree of bitwise operators (&, |, ^ and ~) over vec4state vectors without calculating it. The tree is evaluated in a single pass over the limbs when it is converted to a vec4state, so a chain of bitwise operators reads each operand once and allocates only the result, instead of building a full vector for every operator. Expressions are opt-in: they are started by wrapping a vector with lazy().
+ *
+ * @author Mia Ekheizer, Yuval Shasha
+ * @date 2026-10-16
+ */
+
+#ifndef VEC4STATEEXPR_H
+#define VEC4STATEEXPR_H
+
+#include <algorithm>
+#include "limb.h"
+#include "vec4state.h"
+
+/**
+ * @class vec4state_expr
+ * @brief This class template is the base of the nodes of a lazy bitwise expression over vec4state vectors.
+ *
+ * Every node knows the number of bits of its result and can calculate a single limb of its result (the aval and bval of the limb) from the same limb of its operands. Like the eager operators, an operand that is shorter than the other operand is zero-extended, so the bits of a node that are out of its range are always 0. Converting a node to vec4state evaluates the whole tree limb by limb into a single new vector.
+ *
+ * A node holds its leaves by reference, so the vectors that an expression reads must outlive it. The expression should be evaluated in the statement that builds it (e.g. vec4state result = (lazy(a) & b) | ~c;) rather than be stored with auto.
+ *
+ * @tparam Expr The type of the node that derives from this class.
+ */
+template <typename Expr>
+class vec4state_expr {
+public:
+    /**
+     * @brief Number of bits of the expression.
+     *
+     * @return The number of bits in the result of the expression.
+     */
+    long long getNumBits() const {
+        return self().getNumBits();
+    }
+
+    /**
+     * @brief Conversion operator to vec4state.
+     *
+     * Evaluates the expression in a single pass over the limbs of the result, where each limb of the result is calculated from the same limb of all the leaves of the expression. Only the result vector is allocated.
+     *
+     * @return A vec4state that holds the result of the expression.
+     */
+    operator vec4state() const {
+        vec4state result(self().getNumBits(), vec4state::NO_INIT);
+        limb_t* resultAval = result.aval;
+        limb_t* resultBval = result.bval;
+        limb_t unknownBits = 0;
+        for (long long i = 0; i < result.numLimbs; i++) {
+            self().evaluateLimb(i, resultAval[i], resultBval[i]);
+            unknownBits |= resultBval[i];
+        }
+        result.unknown = unknownBits != 0;
+        return result;
+    }
+
+private:
+    /**
+     * @brief The node that derives from this class.
+     *
+     * @return A reference to this node as its derived type.
+     */
+    const Expr& self() const {
+        return static_cast<const Expr&>(*this);
+    }
+};
+
+/**
+ * @class vec4state_expr_leaf
+ * @brief This class is a leaf of a lazy bitwise expression, which reads the limbs of a vec4state.
+ */
+class vec4state_expr_leaf : public vec4state_expr<vec4state_expr_leaf> {
+public:
+    /**
+     * @brief Constructor for vec4state_expr_leaf.
+     *
+     * Initializes a leaf that reads the planes of vector. The vector must outlive the leaf.
+     *
+     * @param vector The vector to read.
+     */
+    explicit vec4state_expr_leaf(const vec4state& vector) : aval(vector.getAvalPlane()), bval(vector.getBvalPlane()), numLimbs(vector.getNumLimbs()), numBits(vector.getNumBits()) {}
+
+    /**
+     * @brief Number of bits of the leaf.
+     *
+     * @return The number of bits in the vector.
+     */
+    long long getNumBits() const {
+        return numBits;
+    }
+
+    /**
+     * @brief Calculates a limb of the leaf.
+     *
+     * Reads the limb of the vector at index i, where a limb that is out of range of the vector is 0.
+     *
+     * @param i The index of the limb.
+     * @param limbAval Set to the aval of the limb.
+     * @param limbBval Set to the bval of the limb.
+     */
+    void evaluateLimb(long long i, limb_t& limbAval, limb_t& limbBval) const {
+        limbAval = (i < numLimbs) ? aval[i] : 0;
+        limbBval = (i < numLimbs) ? bval[i] : 0;
+    }
+
+private:
+    /**
+     * @brief The aval plane of the vector.
+     */
+    const limb_t* aval;
+
+    /**
+     * @brief The bval plane of the vector.
+     */
+    const limb_t* bval;
+
+    /**
+     * @brief The number of limbs in each plane of the vector.
+     */
+    long long numLimbs;
+
+    /**
+     * @brief The number of bits in the vector.
+     */
+    long long numBits;
+};
+
+/**
+ * @class vec4state_expr_and
+ * @brief This class template is a node of a lazy bitwise expression that calculates the bitwise AND of its operands.
+ *
+ * @tparam Left The type of the left operand.
+ * @tparam Right The type of the right operand.
+ */
+template <typename Left, typename Right>
+class vec4state_expr_and : public vec4state_expr<vec4state_expr_and<Left, Right>> {
+public:
+    /**
+     * @brief Constructor for vec4state_expr_and.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     */
+    vec4state_expr_and(const Left& left, const Right& right) : left(left), right(right) {}
+
+    /**
+     * @brief Number of bits of the node.
+     *
+     * @return The number of bits of the longer operand.
+     */
+    long long getNumBits() const {
+        return max(left.getNumBits(), right.getNumBits());
+    }
+
+    /**
+     * @brief Calculates a limb of the bitwise AND.
+     *
+     * Calculates the limb at index i as in operator&: if at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. Otherwise, the result bit is x.
+     *
+     * @param i The index of the limb.
+     * @param limbAval Set to the aval of the limb.
+     * @param limbBval Set to the bval of the limb.
+     */
+    void evaluateLimb(long long i, limb_t& limbAval, limb_t& limbBval) const {
+        limb_t leftAval, leftBval, rightAval, rightBval;
+        left.evaluateLimb(i, leftAval, leftBval);
+        right.evaluateLimb(i, rightAval, rightBval);
+        limb_t oneBits = (leftAval & ~leftBval) & (rightAval & ~rightBval);
+        limbAval = oneBits;
+        limbBval = (leftAval | leftBval) & (rightAval | rightBval) & ~oneBits;
+    }
+
+private:
+    /**
+     * @brief The left operand.
+     */
+    Left left;
+
+    /**
+     * @brief The right operand.
+     */
+    Right right;
+};
+
+/**
+ * @class vec4state_expr_or
+ * @brief This class template is a node of a lazy bitwise expression that calculates the bitwise OR of its operands.
+ *
+ * @tparam Left The type of the left operand.
+ * @tparam Right The type of the right operand.
+ */
+template <typename Left, typename Right>
+class vec4state_expr_or : public vec4state_expr<vec4state_expr_or<Left, Right>> {
+public:
+    /**
+     * @brief Constructor for vec4state_expr_or.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     */
+    vec4state_expr_or(const Left& left, const Right& right) : left(left), right(right) {}
+
+    /**
+     * @brief Number of bits of the node.
+     *
+     * @return The number of bits of the longer operand.
+     */
+    long long getNumBits() const {
+        return max(left.getNumBits(), right.getNumBits());
+    }
+
+    /**
+     * @brief Calculates a limb of the bitwise OR.
+     *
+     * Calculates the limb at index i as in operator|: if at least one of the bits is 1, the result bit is 1. If both bits are 0, the result bit is 0. Otherwise, the result bit is x.
+     *
+     * @param i The index of the limb.
+     * @param limbAval Set to the aval of the limb.
+     * @param limbBval Set to the bval of the limb.
+     */
+    void evaluateLimb(long long i, limb_t& limbAval, limb_t& limbBval) const {
+        limb_t leftAval, leftBval, rightAval, rightBval;
+        left.evaluateLimb(i, leftAval, leftBval);
+        right.evaluateLimb(i, rightAval, rightBval);
+        limb_t oneBits = (leftAval & ~leftBval) | (rightAval & ~rightBval);
+        limbAval = oneBits;
+        limbBval = (leftBval | rightBval) & ~oneBits;
+    }
+
+private:
+    /**
+     * @brief The left operand.
+     */
+    Left left;
+
+    /**
+     * @brief The right operand.
+     */
+    Right right;
+};
+
+/**
+ * @class vec4state_expr_xor
+ * @brief This class template is a node of a lazy bitwise expression that calculates the bitwise XOR of its operands.
+ *
+ * @tparam Left The type of the left operand.
+ * @tparam Right The type of the right operand.
+ */
+template <typename Left, typename Right>
+class vec4state_expr_xor : public vec4state_expr<vec4state_expr_xor<Left, Right>> {
+public:
+    /**
+     * @brief Constructor for vec4state_expr_xor.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     */
+    vec4state_expr_xor(const Left& left, const Right& right) : left(left), right(right) {}
+
+    /**
+     * @brief Number of bits of the node.
+     *
+     * @return The number of bits of the longer operand.
+     */
+    long long getNumBits() const {
+        return max(left.getNumBits(), right.getNumBits());
+    }
+
+    /**
+     * @brief Calculates a limb of the bitwise XOR.
+     *
+     * Calculates the limb at index i as in operator^: if at least one of the bits is unknown, the result bit is x. Otherwise, the result bit is the XOR of the bits.
+     *
+     * @param i The index of the limb.
+     * @param limbAval Set to the aval of the limb.
+     * @param limbBval Set to the bval of the limb.
+     */
+    void evaluateLimb(long long i, limb_t& limbAval, limb_t& limbBval) const {
+        limb_t leftAval, leftBval, rightAval, rightBval;
+        left.evaluateLimb(i, leftAval, leftBval);
+        right.evaluateLimb(i, rightAval, rightBval);
+        limbBval = leftBval | rightBval;
+        limbAval = (leftAval ^ rightAval) & ~limbBval;
+    }
+
+private:
+    /**
+     * @brief The left operand.
+     */
+    Left left;
+
+    /**
+     * @brief The right operand.
+     */
+    Right right;
+};
+
+/**
+ * @class vec4state_expr_not
+ * @brief This class template is a node of a lazy bitwise expression that calculates the bitwise NOT of its operand.
+ *
+ * @tparam Operand The type of the operand.
+ */
+template <typename Operand>
+class vec4state_expr_not : public vec4state_expr<vec4state_expr_not<Operand>> {
+public:
+    /**
+     * @brief Constructor for vec4state_expr_not.
+     *
+     * @param operand The operand.
+     */
+    explicit vec4state_expr_not(const Operand& operand) : operand(operand) {}
+
+    /**
+     * @brief Number of bits of the node.
+     *
+     * @return The number of bits of the operand.
+     */
+    long long getNumBits() const {
+        return operand.getNumBits();
+    }
+
+    /**
+     * @brief Calculates a limb of the bitwise NOT.
+     *
+     * Calculates the limb at index i as in operator~: a known bit is flipped and an unknown bit becomes x. The bits that are out of range of the operand are zeroed down, so that the node is zero-extended when it is an operand of a longer node.
+     *
+     * @param i The index of the limb.
+     * @param limbAval Set to the aval of the limb.
+     * @param limbBval Set to the bval of the limb.
+     */
+    void evaluateLimb(long long i, limb_t& limbAval, limb_t& limbBval) const {
+        limb_t operandAval, operandBval;
+        operand.evaluateLimb(i, operandAval, operandBval);
+        long long numBits = operand.getNumBits();
+        limb_t mask = 0;
+        if (i < numBits / BITS_IN_LIMB) {
+            mask = MASK_LIMB;
+        } else if (i == numBits / BITS_IN_LIMB && numBits % BITS_IN_LIMB != 0) {
+            mask = MASK_LIMB >> (BITS_IN_LIMB - numBits % BITS_IN_LIMB);
+        }
+        limbAval = ~(operandAval | operandBval) & mask;
+        limbBval = operandBval;
+    }
+
+private:
+    /**
+     * @brief The operand.
+     */
+    Operand operand;
+};
+
+/**
+ * @brief Starts a lazy bitwise expression.
+ *
+ * Wraps vector in a leaf, so the bitwise operators that are applied to it build an expression that is evaluated in a single pass when it is converted to vec4state. The vector must outlive the expression.
+ *
+ * @param vector The vector to read.
+ * @return A leaf that reads vector.
+ */
+inline vec4state_expr_leaf lazy(const vec4state& vector) {
+    return vec4state_expr_leaf(vector);
+}
+
+/**
+ * @brief Bitwise AND operator for lazy expressions.
+ *
+ * @tparam Left The type of the left expression.
+ * @tparam Right The type of the right expression.
+ * @param left The left expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise AND of the expressions.
+ */
+template <typename Left, typename Right>
+vec4state_expr_and<Left, Right> operator&(const vec4state_expr<Left>& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_and<Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise AND operator for a lazy expression and a vector.
+ *
+ * @tparam Left The type of the left expression.
+ * @param left The left expression.
+ * @param right The right vector, which must outlive the expression.
+ * @return A node that calculates the bitwise AND of the expression and the vector.
+ */
+template <typename Left>
+vec4state_expr_and<Left, vec4state_expr_leaf> operator&(const vec4state_expr<Left>& left, const vec4state& right) {
+    return vec4state_expr_and<Left, vec4state_expr_leaf>(static_cast<const Left&>(left), vec4state_expr_leaf(right));
+}
+
+/**
+ * @brief Bitwise AND operator for a vector and a lazy expression.
+ *
+ * @tparam Right The type of the right expression.
+ * @param left The left vector, which must outlive the expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise AND of the vector and the expression.
+ */
+template <typename Right>
+vec4state_expr_and<vec4state_expr_leaf, Right> operator&(const vec4state& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_and<vec4state_expr_leaf, Right>(vec4state_expr_leaf(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise OR operator for lazy expressions.
+ *
+ * @tparam Left The type of the left expression.
+ * @tparam Right The type of the right expression.
+ * @param left The left expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise OR of the expressions.
+ */
+template <typename Left, typename Right>
+vec4state_expr_or<Left, Right> operator|(const vec4state_expr<Left>& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_or<Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise OR operator for a lazy expression and a vector.
+ *
+ * @tparam Left The type of the left expression.
+ * @param left The left expression.
+ * @param right The right vector, which must outlive the expression.
+ * @return A node that calculates the bitwise OR of the expression and the vector.
+ */
+template <typename Left>
+vec4state_expr_or<Left, vec4state_expr_leaf> operator|(const vec4state_expr<Left>& left, const vec4state& right) {
+    return vec4state_expr_or<Left, vec4state_expr_leaf>(static_cast<const Left&>(left), vec4state_expr_leaf(right));
+}
+
+/**
+ * @brief Bitwise OR operator for a vector and a lazy expression.
+ *
+ * @tparam Right The type of the right expression.
+ * @param left The left vector, which must outlive the expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise OR of the vector and the expression.
+ */
+template <typename Right>
+vec4state_expr_or<vec4state_expr_leaf, Right> operator|(const vec4state& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_or<vec4state_expr_leaf, Right>(vec4state_expr_leaf(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise XOR operator for lazy expressions.
+ *
+ * @tparam Left The type of the left expression.
+ * @tparam Right The type of the right expression.
+ * @param left The left expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise XOR of the expressions.
+ */
+template <typename Left, typename Right>
+vec4state_expr_xor<Left, Right> operator^(const vec4state_expr<Left>& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_xor<Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise XOR operator for a lazy expression and a vector.
+ *
+ * @tparam Left The type of the left expression.
+ * @param left The left expression.
+ * @param right The right vector, which must outlive the expression.
+ * @return A node that calculates the bitwise XOR of the expression and the vector.
+ */
+template <typename Left>
+vec4state_expr_xor<Left, vec4state_expr_leaf> operator^(const vec4state_expr<Left>& left, const vec4state& right) {
+    return vec4state_expr_xor<Left, vec4state_expr_leaf>(static_cast<const Left&>(left), vec4state_expr_leaf(right));
+}
+
+/**
+ * @brief Bitwise XOR operator for a vector and a lazy expression.
+ *
+ * @tparam Right The type of the right expression.
+ * @param left The left vector, which must outlive the expression.
+ * @param right The right expression.
+ * @return A node that calculates the bitwise XOR of the vector and the expression.
+ */
+template <typename Right>
+vec4state_expr_xor<vec4state_expr_leaf, Right> operator^(const vec4state& left, const vec4state_expr<Right>& right) {
+    return vec4state_expr_xor<vec4state_expr_leaf, Right>(vec4state_expr_leaf(left), static_cast<const Right&>(right));
+}
+
+/**
+ * @brief Bitwise NOT operator for a lazy expression.
+ *
+ * @tparam Operand The type of the expression.
+ * @param operand The expression.
+ * @return A node that calculates the bitwise NOT of the expression.
+ */
+template <typename Operand>
+vec4state_expr_not<Operand> operator~(const vec4state_expr<Operand>& operand) {
+    return vec4state_expr_not<Operand>(static_cast<const Operand&>(operand));
+}
+
+#endif // VEC4STATEEXPR_H
@@ -0,0 +1,1085 @@
+/**
+ * @file vec4stateFixed.h
+ * @brief Declaration and implementation of the vec4state_fixed class template.
+ *
+ * This file contains the declaration and implementation of the vec4state_fixed class template, which represents a 4-value bit vector whose number of bits is known at compile time. The values are stored in std::arrays inside the object, so the operations never allocate memory on the heap, and the loops over the words of the vector are unrolled for the known number of words.
+ *
+ * @author Mia Ekheizer, Yuval Shasha
+ * @date 2026-10-16
+ */
+
+#ifndef VEC4STATEFIXED_H
+#define VEC4STATEFIXED_H
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include "vec4state.h"
+#include "vec4stateException.h"
+
+/**
+ * @brief The number of bits in a word of vec4state_fixed.
+ */
+#define BITS_IN_FIXED_WORD 64
+
+/**
+ * @brief A mask for all the bits in a word of vec4state_fixed.
+ */
+#define MASK_64 0xFFFFFFFFFFFFFFFFULL
+
+/**
+ * @class vec4state_fixed
+ * @brief This class template represents a vector of N 4-state values, where N is known at compile time.
+ *
+ * The vector supports the same operators as vec4state: bitwise, equality, shift, slice, logical, relational and arithmetic. The values are stored in two arrays of 64-bit words: aval holds the known values and bval marks the unknown values, with the same encoding as VPI (0: aval = 0, bval = 0; 1: aval = 1, bval = 0; x: aval = 0, bval = 1; z: aval = 1, bval = 1). The first word holds the least significant 64 bits, and the bits of the last word that are out of range are always 0.
+ *
+ * Operators between vectors of the same width return a vector of that width, so the arithmetic operators wrap around instead of growing by a bit like vec4state does. Operators between vectors of different widths zero-extend the smaller vector to the width of the larger vector. The relational, equality and logical operators return a 1-bit vector.
+ *
+ * @tparam N The number of bits in the vector, must be positive.
+ */
+template <long long N>
+class vec4state_fixed {
+    static_assert(N > 0, "Number of bits must be positive");
+
+    template <long long M>
+    friend class vec4state_fixed;
+
+public:
+    /**
+     * @brief The number of 64-bit words in the vector.
+     */
+    static constexpr size_t NUM_WORDS = size_t((N + BITS_IN_FIXED_WORD - 1) / BITS_IN_FIXED_WORD);
+
+    /**
+     * @brief Default constructor for vec4state_fixed.
+     *
+     * Initializes a vector of N bits, all initialized to x.
+     */
+    vec4state_fixed() {
+        forEachWord([&](size_t i) {
+            aval[i] = 0;
+            bval[i] = wordMask(i);
+        });
+    }
+
+    /**
+     * @brief Integral constructor for vec4state_fixed.
+     *
+     * Initializes a vector that holds num. Like assigning an integral vec4state to a vector of N bits, the value is truncated to N bits if the type of num has more bits than N, and is zero-extended otherwise.
+     *
+     * @tparam The type of num, must be an integral type.
+     * @param num The value to initialize the vector with.
+     */
+    template<typename T, typename enable_if<is_integral<T>::value, bool>::type = true>
+    vec4state_fixed(T num) {
+        uint64_t value = uint64_t(num);
+        if (sizeof(T) * BITS_IN_BYTE < BITS_IN_FIXED_WORD) {
+            value &= (uint64_t(1) << (sizeof(T) * BITS_IN_BYTE)) - 1;
+        }
+        forEachWord([&](size_t i) {
+            aval[i] = (i == 0) ? (value & wordMask(0)) : 0;
+            bval[i] = 0;
+        });
+    }
+
+    /**
+     * @brief String constructor for vec4state_fixed.
+     *
+     * Initializes a vector with the values represented by str, where the last character of str is the least significant bit. If str has more than N characters, only the last N characters are used. If str has less than N characters, the vector is zero-extended. If str contains a character that is not a BitValue, vec4stateExceptionInvalidInput is thrown.
+     *
+     * @param str The value to initialize the vector with, must be a string that holds only BitValues.
+     */
+    explicit vec4state_fixed(const string& str) {
+        forEachWord([&](size_t i) {
+            aval[i] = 0;
+            bval[i] = 0;
+        });
+        long long length = (long long)(str.length());
+        for (long long bit = 0; bit < length; bit++) {
+            char currChar = str[length - 1 - bit];
+            uint64_t a;
+            uint64_t b;
+            switch (currChar) {
+                case ZERO:
+                    a = 0;
+                    b = 0;
+                    break;
+                case ONE:
+                    a = 1;
+                    b = 0;
+                    break;
+                case X:
+                    a = 0;
+                    b = 1;
+                    break;
+                case Z:
+                    a = 1;
+                    b = 1;
+                    break;
+                default:
+                    throw vec4stateExceptionInvalidInput(string("Invalid bit: ") + currChar);
+            }
+            // Characters beyond N bits are validated but truncated.
+            if (bit < N) {
+                aval[bit / BITS_IN_FIXED_WORD] |= a << (bit % BITS_IN_FIXED_WORD);
+                bval[bit / BITS_IN_FIXED_WORD] |= b << (bit % BITS_IN_FIXED_WORD);
+            }
+        }
+    }
+
+    /**
+     * @brief Conversion constructor from vec4state.
+     *
+     * Initializes a vector that holds the value of other. If other has more than N bits, the value is truncated to N bits. If other has less than N bits, the vector is zero-extended.
+     *
+     * @param other The dynamic vector to convert from.
+     */
+    explicit vec4state_fixed(const vec4state& other) {
+        forEachWord([&](size_t i) {
+            aval[i] = 0;
+            bval[i] = 0;
+            // Each 64-bit word is made of one or more limbs of vec4state.
+            for (long long part = 0; part < BITS_IN_FIXED_WORD / BITS_IN_LIMB; part++) {
+                long long limbIndex = (long long)(i) * (BITS_IN_FIXED_WORD / BITS_IN_LIMB) + part;
+                if (limbIndex < other.numLimbs) {
+                    aval[i] |= uint64_t(other.aval[limbIndex]) << (part * BITS_IN_LIMB);
+                    bval[i] |= uint64_t(other.bval[limbIndex]) << (part * BITS_IN_LIMB);
+                }
+            }
+            aval[i] &= wordMask(i);
+            bval[i] &= wordMask(i);
+        });
+    }
+
+    /**
+     * @brief Conversion constructor from a vec4state_fixed of a different width.
+     *
+     * Initializes a vector that holds the value of other. If other has more than N bits, the value is truncated to N bits. If other has less than N bits, the vector is zero-extended.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector to convert from.
+     */
+    template <long long M>
+    explicit vec4state_fixed(const vec4state_fixed<M>& other) {
+        forEachWord([&](size_t i) {
+            aval[i] = (i < other.NUM_WORDS) ? (other.aval[i] & wordMask(i)) : 0;
+            bval[i] = (i < other.NUM_WORDS) ? (other.bval[i] & wordMask(i)) : 0;
+        });
+    }
+
+    /**
+     * @brief Conversion operator to vec4state.
+     *
+     * Creates a dynamic vector of N bits that holds the value of this vector.
+     *
+     * @return A vec4state of N bits that holds the value of this vector.
+     */
+    operator vec4state() const {
+        vec4state result(ZERO, N);
+        for (long long i = 0; i < result.numLimbs; i++) {
+            size_t word = size_t(i / (BITS_IN_FIXED_WORD / BITS_IN_LIMB));
+            long long shift = (i % (BITS_IN_FIXED_WORD / BITS_IN_LIMB)) * BITS_IN_LIMB;
+            result.aval[i] = limb_t(aval[word] >> shift);
+            result.bval[i] = limb_t(bval[word] >> shift);
+        }
+        result.unknown = isUnknown();
+        return result;
+    }
+
+    /**
+     * @brief Bool conversion operator for vec4state_fixed.
+     *
+     * Checks if the vector holds at least one 1 bit.
+     *
+     * @return true if the vector holds at least one 1 bit.
+     * @return false if the vector holds only 0 or unknown bits.
+     */
+    explicit operator bool() const {
+        uint64_t oneBits = 0;
+        forEachWord([&](size_t i) {
+            oneBits |= aval[i] & ~bval[i];
+        });
+        return oneBits != 0;
+    }
+
+    /**
+     * @brief Bitwise AND operator for vec4state_fixed.
+     *
+     * Calculates the bitwise AND of the vectors in a single pass over the words. If at least one of the bits is 0, the result bit is 0. If both bits are 1, the result bit is 1. Otherwise, the result bit is x.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A new vector that holds the result of the bitwise AND operation.
+     */
+    friend vec4state_fixed operator&(const vec4state_fixed& first, const vec4state_fixed& second) {
+        vec4state_fixed result(NO_INIT);
+        forEachWord([&](size_t i) {
+            uint64_t firstA = first.aval[i], firstB = first.bval[i];
+            uint64_t secondA = second.aval[i], secondB = second.bval[i];
+            result.aval[i] = firstA & ~firstB & secondA & ~secondB;
+            result.bval[i] = (firstB | secondB) & (firstA | firstB) & (secondA | secondB);
+        });
+        return result;
+    }
+
+    /**
+     * @brief Bitwise OR operator for vec4state_fixed.
+     *
+     * Calculates the bitwise OR of the vectors in a single pass over the words. If at least one of the bits is 1, the result bit is 1. If both bits are 0, the result bit is 0. Otherwise, the result bit is x.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A new vector that holds the result of the bitwise OR operation.
+     */
+    friend vec4state_fixed operator|(const vec4state_fixed& first, const vec4state_fixed& second) {
+        vec4state_fixed result(NO_INIT);
+        forEachWord([&](size_t i) {
+            uint64_t firstA = first.aval[i], firstB = first.bval[i];
+            uint64_t secondA = second.aval[i], secondB = second.bval[i];
+            result.aval[i] = (firstA & ~firstB) | (secondA & ~secondB);
+            result.bval[i] = (firstB | secondB) & ~result.aval[i];
+        });
+        return result;
+    }
+
+    /**
+     * @brief Bitwise XOR operator for vec4state_fixed.
+     *
+     * Calculates the bitwise XOR of the vectors in a single pass over the words. If at least one of the bits is unknown, the result bit is x. If both bits are equal, the result bit is 0. Otherwise, the result bit is 1.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A new vector that holds the result of the bitwise XOR operation.
+     */
+    friend vec4state_fixed operator^(const vec4state_fixed& first, const vec4state_fixed& second) {
+        vec4state_fixed result(NO_INIT);
+        forEachWord([&](size_t i) {
+            result.bval[i] = first.bval[i] | second.bval[i];
+            result.aval[i] = (first.aval[i] ^ second.aval[i]) & ~result.bval[i];
+        });
+        return result;
+    }
+
+    /**
+     * @brief Bitwise AND operator for vectors of different widths.
+     *
+     * Zero-extends the smaller vector to the width of the larger vector and calculates the bitwise AND of the vectors.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector to perform the bitwise AND operation with.
+     * @return A new vector of max(N, M) bits that holds the result of the bitwise AND operation.
+     */
+    template <long long M>
+    vec4state_fixed<(N > M ? N : M)> operator&(const vec4state_fixed<M>& other) const {
+        return vec4state_fixed<(N > M ? N : M)>(*this) & vec4state_fixed<(N > M ? N : M)>(other);
+    }
+
+    /**
+     * @brief Bitwise OR operator for vectors of different widths.
+     *
+     * Zero-extends the smaller vector to the width of the larger vector and calculates the bitwise OR of the vectors.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector to perform the bitwise OR operation with.
+     * @return A new vector of max(N, M) bits that holds the result of the bitwise OR operation.
+     */
+    template <long long M>
+    vec4state_fixed<(N > M ? N : M)> operator|(const vec4state_fixed<M>& other) const {
+        return vec4state_fixed<(N > M ? N : M)>(*this) | vec4state_fixed<(N > M ? N : M)>(other);
+    }
+
+    /**
+     * @brief Bitwise XOR operator for vectors of different widths.
+     *
+     * Zero-extends the smaller vector to the width of the larger vector and calculates the bitwise XOR of the vectors.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector to perform the bitwise XOR operation with.
+     * @return A new vector of max(N, M) bits that holds the result of the bitwise XOR operation.
+     */
+    template <long long M>
+    vec4state_fixed<(N > M ? N : M)> operator^(const vec4state_fixed<M>& other) const {
+        return vec4state_fixed<(N > M ? N : M)>(*this) ^ vec4state_fixed<(N > M ? N : M)>(other);
+    }
+
+    /**
+     * @brief Bitwise NOT operator for vec4state_fixed.
+     *
+     * Calculates the bitwise NOT of each bit in the vector. If the bit is 0, the result bit is 1. If the bit is 1, the result bit is 0. If the bit is unknown, the result bit is x.
+     *
+     * @return A new vector that holds the result of the bitwise NOT operation.
+     */
+    vec4state_fixed operator~() const {
+        vec4state_fixed result(NO_INIT);
+        forEachWord([&](size_t i) {
+            result.aval[i] = ~(aval[i] | bval[i]) & wordMask(i);
+            result.bval[i] = bval[i];
+        });
+        return result;
+    }
+
+    /**
+     * @brief Logical equality operator for vec4state_fixed.
+     *
+     * Compares the vectors bit for bit. If a known bit in one vector differs from the corresponding known bit in the other vector, the vectors are not equal. Otherwise, if one of the vectors has unknown bits, the comparison is ambiguous.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b0 if the comparison fails.
+     * @return 1'b1 if the comparison succeeds.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator==(const vec4state_fixed& first, const vec4state_fixed& second) {
+        uint64_t knownDiff = 0;
+        uint64_t unknownBits = 0;
+        forEachWord([&](size_t i) {
+            knownDiff |= (first.aval[i] ^ second.aval[i]) & ~(first.bval[i] | second.bval[i]);
+            unknownBits |= first.bval[i] | second.bval[i];
+        });
+        if (knownDiff != 0) {
+            return vec4state_fixed<1>::fromBit(ZERO);
+        }
+        return vec4state_fixed<1>::fromBit(unknownBits != 0 ? X : ONE);
+    }
+
+    /**
+     * @brief Logical inequality operator for vec4state_fixed.
+     *
+     * Compares the vectors bit for bit by checking if the vectors are equal using the logical equality operator, and then negating the result.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if the comparison fails.
+     * @return 1'b0 if the comparison succeeds.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator!=(const vec4state_fixed& first, const vec4state_fixed& second) {
+        return !(first == second);
+    }
+
+    /**
+     * @brief Case equality operator for vec4state_fixed.
+     *
+     * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison and shall match for the result to be considered equal.
+     *
+     * @param other The vector to compare to.
+     * @return 1'b0 if the comparison fails.
+     * @return 1'b1 if the comparison succeeds.
+     */
+    vec4state_fixed<1> caseEquality(const vec4state_fixed& other) const {
+        uint64_t diff = 0;
+        forEachWord([&](size_t i) {
+            diff |= (aval[i] ^ other.aval[i]) | (bval[i] ^ other.bval[i]);
+        });
+        return vec4state_fixed<1>::fromBit(diff == 0 ? ONE : ZERO);
+    }
+
+    /**
+     * @brief Case inequality operator for vec4state_fixed.
+     *
+     * Compares this vector to other vector bit for bit, where the unknown bits are included in the comparison. The method calculates the case equality of the vectors and then negates the result.
+     *
+     * @param other The vector to compare to.
+     * @return 1'b1 if the comparison fails.
+     * @return 1'b0 if the comparison succeeds.
+     */
+    vec4state_fixed<1> caseInequality(const vec4state_fixed& other) const {
+        return !caseEquality(other);
+    }
+
+    /**
+     * @brief Logical shift left operator for vec4state_fixed.
+     *
+     * Shifts this vector to the left by num bit positions. The vacated bit positions are filled with zeros. If num is negative or not less than N, the result is a vector of 0's.
+     *
+     * @param num The number of bit positions to shift by.
+     * @return A new vector that holds the result of the logical shift left operation.
+     */
+    vec4state_fixed operator<<(long long num) const {
+        if (num < 0 || num >= N) {
+            return vec4state_fixed(0);
+        }
+        vec4state_fixed result(NO_INIT);
+        long long wordShift = num / BITS_IN_FIXED_WORD;
+        long long bitShift = num % BITS_IN_FIXED_WORD;
+        forEachWord([&](size_t i) {
+            long long source = (long long)(i) - wordShift;
+            uint64_t a = (source >= 0) ? (aval[source] << bitShift) : 0;
+            uint64_t b = (source >= 0) ? (bval[source] << bitShift) : 0;
+            // Bring in the bits that are shifted out of the previous word.
+            if (bitShift != 0 && source >= 1) {
+                a |= aval[source - 1] >> (BITS_IN_FIXED_WORD - bitShift);
+                b |= bval[source - 1] >> (BITS_IN_FIXED_WORD - bitShift);
+            }
+            result.aval[i] = a & wordMask(i);
+            result.bval[i] = b & wordMask(i);
+        });
+        return result;
+    }
+
+    /**
+     * @brief Logical shift left operator for vec4state_fixed.
+     *
+     * Extracts the value stored in other vector, then shifts this vector to the left by that number of bit positions. If other vector holds unknown bits, the result is only x's.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A new vector that holds the result of the logical shift left operation.
+     */
+    template <long long M>
+    vec4state_fixed operator<<(const vec4state_fixed<M>& other) const {
+        if (other.isUnknown()) {
+            return vec4state_fixed();
+        }
+        return *this << other.shiftAmount();
+    }
+
+    /**
+     * @brief Logical shift right operator for vec4state_fixed.
+     *
+     * Shifts this vector to the right by num bit positions. The vacated bit positions are filled with zeros. If num is negative or not less than N, the result is a vector of 0's.
+     *
+     * @param num The number of bit positions to shift by.
+     * @return A new vector that holds the result of the logical shift right operation.
+     */
+    vec4state_fixed operator>>(long long num) const {
+        if (num < 0 || num >= N) {
+            return vec4state_fixed(0);
+        }
+        vec4state_fixed result(NO_INIT);
+        long long wordShift = num / BITS_IN_FIXED_WORD;
+        long long bitShift = num % BITS_IN_FIXED_WORD;
+        forEachWord([&](size_t i) {
+            long long source = (long long)(i) + wordShift;
+            uint64_t a = (source < (long long)(NUM_WORDS)) ? (aval[source] >> bitShift) : 0;
+            uint64_t b = (source < (long long)(NUM_WORDS)) ? (bval[source] >> bitShift) : 0;
+            // Bring in the bits that are shifted out of the next word.
+            if (bitShift != 0 && source + 1 < (long long)(NUM_WORDS)) {
+                a |= aval[source + 1] << (BITS_IN_FIXED_WORD - bitShift);
+                b |= bval[source + 1] << (BITS_IN_FIXED_WORD - bitShift);
+            }
+            result.aval[i] = a;
+            result.bval[i] = b;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Logical shift right operator for vec4state_fixed.
+     *
+     * Extracts the value stored in other vector, then shifts this vector to the right by that number of bit positions. If other vector holds unknown bits, the result is only x's.
+     *
+     * @tparam M The number of bits in other.
+     * @param other The vector that holds the number of bit positions to shift by.
+     * @return A new vector that holds the result of the logical shift right operation.
+     */
+    template <long long M>
+    vec4state_fixed operator>>(const vec4state_fixed<M>& other) const {
+        if (other.isUnknown()) {
+            return vec4state_fixed();
+        }
+        return *this >> other.shiftAmount();
+    }
+
+    /**
+     * @brief Get bit select operator for vec4state_fixed.
+     *
+     * Extracts the bit stored in this vector at the given index.
+     *
+     * @param index The index of the bit to extract.
+     * @return The value of the bit at index index in this vector. If the index is out of range, the result is x.
+     */
+    vec4state_fixed<1> getBitSelect(long long index) const {
+        vec4state_fixed<1> result(vec4state_fixed<1>::NO_INIT);
+        result.aval[0] = 0;
+        result.bval[0] = 1;
+        if (index >= 0 && index < N) {
+            result.aval[0] = (aval[size_t(index / BITS_IN_FIXED_WORD)] >> (index % BITS_IN_FIXED_WORD)) & 1;
+            result.bval[0] = (bval[size_t(index / BITS_IN_FIXED_WORD)] >> (index % BITS_IN_FIXED_WORD)) & 1;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Set bit select operator for vec4state_fixed.
+     *
+     * Sets the bit stored in this vector at the given index to the value stored in newValue.
+     *
+     * @param index The index of the bit to set.
+     * @param newValue The value to set the bit to. If the index is out of range, this vector remains unchanged.
+     */
+    void setBitSelect(long long index, const vec4state_fixed<1>& newValue) {
+        if (index < 0 || index >= N) {
+            return;
+        }
+        size_t word = size_t(index / BITS_IN_FIXED_WORD);
+        uint64_t mask = uint64_t(1) << (index % BITS_IN_FIXED_WORD);
+        aval[word] = (aval[word] & ~mask) | (newValue.aval[0] ? mask : 0);
+        bval[word] = (bval[word] & ~mask) | (newValue.bval[0] ? mask : 0);
+    }
+
+    /**
+     * @brief Get part select operator for vec4state_fixed.
+     *
+     * Extracts the part of this vector from index START to index END. The bits of the part that are out of range are set to x.
+     *
+     * @tparam END The end index of the part to extract.
+     * @tparam START The start index of the part to extract, must not be greater than END.
+     * @return The part of this vector from index START to index END.
+     */
+    template <long long END, long long START>
+    vec4state_fixed<END - START + 1> getPartSelect() const {
+        static_assert(END >= START, "End index must not be less than start index");
+        vec4state_fixed<END - START + 1> result(vec4state_fixed<END - START + 1>::NO_INIT);
+        for (size_t i = 0; i < result.NUM_WORDS; i++) {
+            getBitsAt(START + (long long)(i) * BITS_IN_FIXED_WORD, result.aval[i], result.bval[i]);
+            result.aval[i] &= result.wordMask(i);
+            result.bval[i] &= result.wordMask(i);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Set part select operator for vec4state_fixed.
+     *
+     * Sets the part of this vector from index START to index END to the value stored in newValue. The bits of the part that are out of range are ignored.
+     *
+     * @tparam END The end index of the part to set.
+     * @tparam START The start index of the part to set, must not be greater than END.
+     * @param newValue The value to set the part to.
+     */
+    template <long long END, long long START>
+    void setPartSelect(const vec4state_fixed<END - START + 1>& newValue) {
+        static_assert(END >= START, "End index must not be less than start index");
+        for (size_t i = 0; i < newValue.NUM_WORDS; i++) {
+            setBitsAt(START + (long long)(i) * BITS_IN_FIXED_WORD, newValue.aval[i], newValue.bval[i], newValue.wordMask(i));
+        }
+    }
+
+    /**
+     * @brief Logical AND operator for vec4state_fixed.
+     *
+     * Checks if both vectors are true (hold at least one 1 bit).
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if both vectors are true.
+     * @return 1'b0 if one of the vectors is false.
+     * @return 1'bx if one of the vectors is unknown and the other vector is true, or if both vectors are unknown.
+     */
+    friend vec4state_fixed<1> operator&&(const vec4state_fixed& first, const vec4state_fixed& second) {
+        bool firstTrue = bool(first);
+        bool secondTrue = bool(second);
+        if (firstTrue && secondTrue) {
+            return vec4state_fixed<1>::fromBit(ONE);
+        }
+        if ((firstTrue && second.isUnknown()) || (secondTrue && first.isUnknown()) || (first.isUnknown() && second.isUnknown())) {
+            return vec4state_fixed<1>::fromBit(X);
+        }
+        return vec4state_fixed<1>::fromBit(ZERO);
+    }
+
+    /**
+     * @brief Logical OR operator for vec4state_fixed.
+     *
+     * Checks if at least one of the vectors is true (holds at least one 1 bit).
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if one of the vectors is true.
+     * @return 1'b0 if both vectors are false.
+     * @return 1'bx if one of the vectors is unknown and the other vector is false.
+     */
+    friend vec4state_fixed<1> operator||(const vec4state_fixed& first, const vec4state_fixed& second) {
+        if (bool(first) || bool(second)) {
+            return vec4state_fixed<1>::fromBit(ONE);
+        }
+        if (first.isUnknown() || second.isUnknown()) {
+            return vec4state_fixed<1>::fromBit(X);
+        }
+        return vec4state_fixed<1>::fromBit(ZERO);
+    }
+
+    /**
+     * @brief Logical NOT operator for vec4state_fixed.
+     *
+     * Checks if this vector is true (holds at least one 1 bit).
+     *
+     * @return 1'b0 if the vector is true.
+     * @return 1'b1 if the vector is false.
+     * @return 1'bx if the vector has an ambiguous truth value.
+     */
+    vec4state_fixed<1> operator!() const {
+        if (bool(*this)) {
+            return vec4state_fixed<1>::fromBit(ZERO);
+        }
+        return vec4state_fixed<1>::fromBit(isUnknown() ? X : ONE);
+    }
+
+    /**
+     * @brief Less than relational operator for vec4state_fixed.
+     *
+     * Checks if the first vector is less than the second vector by comparing the words from the most significant word to the least significant word.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if the first vector is less than the second vector.
+     * @return 1'b0 if the first vector is greater than or equal to the second vector.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator<(const vec4state_fixed& first, const vec4state_fixed& second) {
+        if (first.isUnknown() || second.isUnknown()) {
+            return vec4state_fixed<1>::fromBit(X);
+        }
+        return vec4state_fixed<1>::fromBit(compareKnown(first, second) < 0 ? ONE : ZERO);
+    }
+
+    /**
+     * @brief Greater than relational operator for vec4state_fixed.
+     *
+     * Checks if the first vector is greater than the second vector by checking if the second vector is less than the first vector.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if the first vector is greater than the second vector.
+     * @return 1'b0 if the first vector is less than or equal to the second vector.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator>(const vec4state_fixed& first, const vec4state_fixed& second) {
+        return second < first;
+    }
+
+    /**
+     * @brief Less than or equal to relational operator for vec4state_fixed.
+     *
+     * Checks if the first vector is less than or equal to the second vector by checking if the first vector is greater than the second vector, and then negating the result.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if the first vector is less than or equal to the second vector.
+     * @return 1'b0 if the first vector is greater than the second vector.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator<=(const vec4state_fixed& first, const vec4state_fixed& second) {
+        return !(first > second);
+    }
+
+    /**
+     * @brief Greater than or equal to relational operator for vec4state_fixed.
+     *
+     * Checks if the first vector is greater than or equal to the second vector by checking if the first vector is less than the second vector, and then negating the result.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return 1'b1 if the first vector is greater than or equal to the second vector.
+     * @return 1'b0 if the first vector is less than the second vector.
+     * @return 1'bx if the comparison is ambiguous (due to unknown bits in one of the vectors).
+     */
+    friend vec4state_fixed<1> operator>=(const vec4state_fixed& first, const vec4state_fixed& second) {
+        return !(first < second);
+    }
+
+    /**
+     * @brief Addition operator for vec4state_fixed.
+     *
+     * Calculates the sum of the vectors modulo 2^N by adding the words with a carry chain.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A new vector that holds the result of the addition operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    friend vec4state_fixed operator+(const vec4state_fixed& first, const vec4state_fixed& second) {
+        if (first.isUnknown() || second.isUnknown()) {
+            return vec4state_fixed();
+        }
+        vec4state_fixed result(NO_INIT);
+        uint64_t carry = 0;
+        forEachWord([&](size_t i) {
+            uint64_t sum = first.aval[i] + second.aval[i];
+            uint64_t carryOut = sum < first.aval[i];
+            result.aval[i] = sum + carry;
+            carry = carryOut | (result.aval[i] < sum);
+            result.aval[i] &= wordMask(i);
+            result.bval[i] = 0;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Subtraction operator for vec4state_fixed.
+     *
+     * Calculates the difference of the vectors modulo 2^N by subtracting the words with a borrow chain.
+     *
+     * @param first The vector to subtract from.
+     * @param second The vector to subtract.
+     * @return A new vector that holds the result of the subtraction operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    friend vec4state_fixed operator-(const vec4state_fixed& first, const vec4state_fixed& second) {
+        if (first.isUnknown() || second.isUnknown()) {
+            return vec4state_fixed();
+        }
+        vec4state_fixed result(NO_INIT);
+        uint64_t borrow = 0;
+        forEachWord([&](size_t i) {
+            uint64_t difference = first.aval[i] - second.aval[i];
+            uint64_t borrowOut = first.aval[i] < second.aval[i];
+            result.aval[i] = difference - borrow;
+            borrow = borrowOut | (difference < borrow);
+            result.aval[i] &= wordMask(i);
+            result.bval[i] = 0;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Multiplication operator for vec4state_fixed.
+     *
+     * Calculates the product of the vectors modulo 2^N. Single-word vectors are multiplied directly, and wider vectors are multiplied word by word, keeping only the lower N bits of the product.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A new vector that holds the result of the multiplication operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    friend vec4state_fixed operator*(const vec4state_fixed& first, const vec4state_fixed& second) {
+        if (first.isUnknown() || second.isUnknown()) {
+            return vec4state_fixed();
+        }
+        vec4state_fixed result(0);
+        if (NUM_WORDS == 1) {
+            result.aval[0] = (first.aval[0] * second.aval[0]) & wordMask(0);
+            return result;
+        }
+        for (size_t i = 0; i < NUM_WORDS; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; i + j < NUM_WORDS; j++) {
+                uint64_t high;
+                uint64_t low = mulWide(first.aval[i], second.aval[j], high);
+                // Add the low part of the product and the carry to the result word.
+                uint64_t sum = result.aval[i + j] + low;
+                high += sum < low;
+                result.aval[i + j] = sum + carry;
+                high += result.aval[i + j] < sum;
+                carry = high;
+            }
+        }
+        result.aval[NUM_WORDS - 1] &= wordMask(NUM_WORDS - 1);
+        return result;
+    }
+
+    /**
+     * @brief Division operator for vec4state_fixed.
+     *
+     * Calculates the division of the first vector by the second vector. Single-word vectors are divided directly, and wider vectors are divided using binary long division. If the second vector is 0, vec4stateExceptionInvalidOperation is thrown.
+     *
+     * @param first The vector to divide.
+     * @param second The vector to divide by.
+     * @return A new vector that holds the result of the division operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    friend vec4state_fixed operator/(const vec4state_fixed& first, const vec4state_fixed& second) {
+        vec4state_fixed quotient(NO_INIT);
+        vec4state_fixed remainder(NO_INIT);
+        divide(first, second, quotient, remainder);
+        return quotient;
+    }
+
+    /**
+     * @brief Modulus operator for vec4state_fixed.
+     *
+     * Calculates the modulus of the first vector by the second vector. Single-word vectors are divided directly, and wider vectors are divided using binary long division. If the second vector is 0, vec4stateExceptionInvalidOperation is thrown.
+     *
+     * @param first The vector to divide.
+     * @param second The vector to calculate the modulus by.
+     * @return A new vector that holds the result of the modulus operation. If one of the vectors holds unknown bits, then the result is only x's.
+     */
+    friend vec4state_fixed operator%(const vec4state_fixed& first, const vec4state_fixed& second) {
+        vec4state_fixed quotient(NO_INIT);
+        vec4state_fixed remainder(NO_INIT);
+        divide(first, second, quotient, remainder);
+        return remainder;
+    }
+
+    /**
+     * @brief Minus operator for vec4state_fixed.
+     *
+     * Calculates the two's complement of this vector modulo 2^N.
+     *
+     * @return A new vector that holds the result of the minus operation. If this vector holds unknown bits, then the result is only x's.
+     */
+    vec4state_fixed operator-() const {
+        return vec4state_fixed(0) - *this;
+    }
+
+    /**
+     * @brief Conversion operator to vec2state for vec4state_fixed.
+     *
+     * Converts this vector to a 2-state vector by replacing all the unknown values with 0's.
+     */
+    void convertTo2State() {
+        forEachWord([&](size_t i) {
+            aval[i] &= ~bval[i];
+            bval[i] = 0;
+        });
+    }
+
+    /**
+     * @brief Gets the number of bits in this vector.
+     *
+     * @return The number of bits in this vector.
+     */
+    static constexpr long long getNumBits() {
+        return N;
+    }
+
+    /**
+     * @brief Checks if the vector contains any unknown values.
+     *
+     * @return true if the vector contains any unknown values.
+     * @return false if the vector does not contain any unknown values.
+     */
+    bool isUnknown() const {
+        uint64_t unknownBits = 0;
+        forEachWord([&](size_t i) {
+            unknownBits |= bval[i];
+        });
+        return unknownBits != 0;
+    }
+
+    /**
+     * @brief String representation of the vector.
+     *
+     * Creates a string representation of the vector, where each bit is represented by it's corresponding BitValue (0, 1, x, or z), from the MSB to the LSB.
+     *
+     * @return A string representation of the vector.
+     */
+    string toString() const {
+        string result((size_t)N, char(ZERO));
+        for (long long bit = 0; bit < N; bit++) {
+            bool a = (aval[size_t(bit / BITS_IN_FIXED_WORD)] >> (bit % BITS_IN_FIXED_WORD)) & 1;
+            bool b = (bval[size_t(bit / BITS_IN_FIXED_WORD)] >> (bit % BITS_IN_FIXED_WORD)) & 1;
+            result[size_t(N - 1 - bit)] = b ? (a ? Z : X) : (a ? ONE : ZERO);
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Tag type for the constructor that leaves the words uninitialized.
+     */
+    enum NoInit { NO_INIT };
+
+    /**
+     * @brief Uninitialized constructor for vec4state_fixed.
+     *
+     * Used internally by operators that overwrite every word of the result.
+     */
+    explicit vec4state_fixed(NoInit) {}
+
+    /**
+     * @brief Creates a 1-bit vector that holds bit.
+     *
+     * @param bit The value of the bit.
+     * @return A 1-bit vector that holds bit.
+     */
+    static vec4state_fixed fromBit(BitValue bit) {
+        vec4state_fixed result(NO_INIT);
+        result.aval[0] = (bit == ONE || bit == Z) ? 1 : 0;
+        result.bval[0] = (bit == X || bit == Z) ? 1 : 0;
+        return result;
+    }
+
+    /**
+     * @brief Gets the mask of the bits that are in range in a word.
+     *
+     * @param index The index of the word.
+     * @return A mask with 1's in the bits of the word that are in range.
+     */
+    static constexpr uint64_t wordMask(size_t index) {
+        return (index + 1 < NUM_WORDS || N % BITS_IN_FIXED_WORD == 0) ? MASK_64 : (MASK_64 >> ((BITS_IN_FIXED_WORD - N % BITS_IN_FIXED_WORD) % BITS_IN_FIXED_WORD));
+    }
+
+    /**
+     * @brief Helper function for calling func for each word index.
+     *
+     * The calls are expanded at compile time for the known number of words, so the loop is fully unrolled.
+     *
+     * @tparam Func The type of the function.
+     * @param func The function to call with each word index.
+     */
+    template <typename Func>
+    static void forEachWord(Func&& func) {
+        forEachWordImpl(func, make_index_sequence<NUM_WORDS>());
+    }
+
+    /**
+     * @brief Implementation of forEachWord.
+     *
+     * @tparam Func The type of the function.
+     * @tparam I The word indices.
+     * @param func The function to call with each word index.
+     */
+    template <typename Func, size_t... I>
+    static void forEachWordImpl(Func& func, index_sequence<I...>) {
+        (func(I), ...);
+    }
+
+    /**
+     * @brief Multiplies two 64-bit words into a 128-bit product.
+     *
+     * @param first The first word.
+     * @param second The second word.
+     * @param high Set to the upper 64 bits of the product.
+     * @return The lower 64 bits of the product.
+     */
+    static uint64_t mulWide(uint64_t first, uint64_t second, uint64_t& high) {
+        uint64_t firstLow = first & MASK_32, firstHigh = first >> BITS_IN_VPI;
+        uint64_t secondLow = second & MASK_32, secondHigh = second >> BITS_IN_VPI;
+        uint64_t lowLow = firstLow * secondLow;
+        uint64_t lowHigh = firstLow * secondHigh;
+        uint64_t highLow = firstHigh * secondLow;
+        uint64_t highHigh = firstHigh * secondHigh;
+        uint64_t middle = (lowLow >> BITS_IN_VPI) + (lowHigh & MASK_32) + (highLow & MASK_32);
+        high = highHigh + (lowHigh >> BITS_IN_VPI) + (highLow >> BITS_IN_VPI) + (middle >> BITS_IN_VPI);
+        return (middle << BITS_IN_VPI) | (lowLow & MASK_32);
+    }
+
+    /**
+     * @brief Compares two known vectors.
+     *
+     * @param first The first vector.
+     * @param second The second vector.
+     * @return A negative number if first < second, 0 if they are equal and a positive number if first > second.
+     */
+    static int compareKnown(const vec4state_fixed& first, const vec4state_fixed& second) {
+        for (size_t i = NUM_WORDS; i-- > 0;) {
+            if (first.aval[i] != second.aval[i]) {
+                return first.aval[i] < second.aval[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Divides two vectors.
+     *
+     * Calculates the quotient and the remainder of the division of first by second. If one of the vectors holds unknown bits, both results are only x's. If second is 0, vec4stateExceptionInvalidOperation is thrown.
+     *
+     * @param first The vector to divide.
+     * @param second The vector to divide by.
+     * @param quotient Set to the quotient of the division.
+     * @param remainder Set to the remainder of the division.
+     */
+    static void divide(const vec4state_fixed& first, const vec4state_fixed& second, vec4state_fixed& quotient, vec4state_fixed& remainder) {
+        if (!bool(second) && !second.isUnknown()) {
+            throw vec4stateExceptionInvalidOperation("Division by zero is not allowed");
+        }
+        if (first.isUnknown() || second.isUnknown()) {
+            quotient = vec4state_fixed();
+            remainder = vec4state_fixed();
+            return;
+        }
+        if (NUM_WORDS == 1) {
+            quotient = vec4state_fixed(first.aval[0] / second.aval[0]);
+            remainder = vec4state_fixed(first.aval[0] % second.aval[0]);
+            return;
+        }
+        quotient = vec4state_fixed(0);
+        remainder = vec4state_fixed(0);
+        // Binary long division, from the most significant bit to the least significant bit.
+        for (long long bit = N - 1; bit >= 0; bit--) {
+            remainder = remainder << 1;
+            remainder.aval[0] |= (first.aval[size_t(bit / BITS_IN_FIXED_WORD)] >> (bit % BITS_IN_FIXED_WORD)) & 1;
+            if (compareKnown(remainder, second) >= 0) {
+                remainder = remainder - second;
+                quotient.aval[size_t(bit / BITS_IN_FIXED_WORD)] |= uint64_t(1) << (bit % BITS_IN_FIXED_WORD);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the shift amount that this known vector holds.
+     *
+     * @return The value of the vector, or N if the value does not fit in a non-negative long long.
+     */
+    long long shiftAmount() const {
+        for (size_t i = 1; i < NUM_WORDS; i++) {
+            if (aval[i] != 0) {
+                return N;
+            }
+        }
+        return (aval[0] > uint64_t(N)) ? N : (long long)(aval[0]);
+    }
+
+    /**
+     * @brief Gets 64 bits of the vector starting at bit position start.
+     *
+     * Bits that are out of range (negative positions or positions not less than N) are returned as x.
+     *
+     * @param start The position of the first bit to get, can be out of range.
+     * @param a Set to the aval of the bits.
+     * @param b Set to the bval of the bits.
+     */
+    void getBitsAt(long long start, uint64_t& a, uint64_t& b) const {
+        a = 0;
+        b = 0;
+        uint64_t inRange = 0;
+        for (long long bit = 0; bit < BITS_IN_FIXED_WORD; bit++) {
+            long long position = start + bit;
+            if (position < 0 || position >= N) {
+                continue;
+            }
+            // Copy whole runs of bits that are in the same word at once.
+            long long offset = position % BITS_IN_FIXED_WORD;
+            long long count = min(BITS_IN_FIXED_WORD - offset, BITS_IN_FIXED_WORD - bit);
+            count = min(count, N - position);
+            uint64_t runMask = (count == BITS_IN_FIXED_WORD) ? MASK_64 : ((uint64_t(1) << count) - 1);
+            a |= ((aval[size_t(position / BITS_IN_FIXED_WORD)] >> offset) & runMask) << bit;
+            b |= ((bval[size_t(position / BITS_IN_FIXED_WORD)] >> offset) & runMask) << bit;
+            inRange |= runMask << bit;
+            bit += count - 1;
+        }
+        b |= ~inRange;
+    }
+
+    /**
+     * @brief Sets the bits of the vector starting at bit position start.
+     *
+     * Bits that are out of range (negative positions or positions not less than N) are ignored.
+     *
+     * @param start The position of the first bit to set, can be out of range.
+     * @param a The aval of the bits.
+     * @param b The bval of the bits.
+     * @param mask The bits of a and b that should be set.
+     */
+    void setBitsAt(long long start, uint64_t a, uint64_t b, uint64_t mask) {
+        for (long long bit = 0; bit < BITS_IN_FIXED_WORD; bit++) {
+            long long position = start + bit;
+            if (position < 0 || position >= N || ((mask >> bit) & 1) == 0) {
+                continue;
+            }
+            // Copy whole runs of bits that are in the same word at once.
+            long long offset = position % BITS_IN_FIXED_WORD;
+            long long count = min(BITS_IN_FIXED_WORD - offset, BITS_IN_FIXED_WORD - bit);
+            count = min(count, N - position);
+            uint64_t runMask = ((count == BITS_IN_FIXED_WORD) ? MASK_64 : ((uint64_t(1) << count) - 1)) & (mask >> bit);
+            size_t word = size_t(position / BITS_IN_FIXED_WORD);
+            aval[word] = (aval[word] & ~(runMask << offset)) | (((a >> bit) & runMask) << offset);
+            bval[word] = (bval[word] & ~(runMask << offset)) | (((b >> bit) & runMask) << offset);
+            bit += count - 1;
+        }
+    }
+
+    /**
+     * @brief The aval words of the vector, which represent the known values of the 4-state vector - 0 and 1.
+     */
+    array<uint64_t, NUM_WORDS> aval;
+
+    /**
+     * @brief The bval words of the vector, which represent the unknown values of the 4-state vector - x and z.
+     */
+    array<uint64_t, NUM_WORDS> bval;
+};
+
+#endif // VEC4STATEFIXED_H